@@ -315,7 +315,7 @@ bool CommandLineInterface::openProject(
                            "*.lppz files!"));
         success = false;
       } else {
-        project.save();                                          // can throw
+        project.save(true);  // can throw, force writing all files
         QStringList paths = projectFs->checkForModifications();  // can throw
         // ignore user config files
         paths = paths.filter(QRegularExpression("^((?!\\.user\\.lp).)*$"));
@@ -486,8 +486,9 @@ bool CommandLineInterface::openProject(
           boardList.clear();  // avoid exporting any boards
         }
       }
-      foreach (const Board* board, boardList) {
+      foreach (Board* board, boardList) {
         print("  " % QString(tr("Board '%1':")).arg(*board->getName()));
+        board->rebuildAllPlanes();  // not yet built after opening the project
         BoardGerberExport grbExport(
             *board, customSettings ? *customSettings
                                    : board->getFabricationOutputSettings());
@@ -505,7 +506,7 @@ bool CommandLineInterface::openProject(
       if (failIfFileFormatUnstable()) {
         success = false;
       } else {
-        project.save();  // can throw
+        project.save(true);  // can throw, force writing all files
         if (projectFp.getSuffix() == "lppz") {
           projectFs->exportToZip(projectFp);  // can throw
         } else {
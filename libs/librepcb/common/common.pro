@@ -23,7 +23,6 @@ INCLUDEPATH += \
     ../../ \
     ../../fontobene \
     ../../quazip \
-    ../../sexpresso \
     ../../type_safe/include \
     ../../type_safe/external/debug_assert \
 
@@ -70,7 +69,9 @@ SOURCES += \
     fileio/directorylock.cpp \
     fileio/filepath.cpp \
     fileio/fileutils.cpp \
+    fileio/fileview.cpp \
     fileio/sexpression.cpp \
+    fileio/sexpressioncache.cpp \
     fileio/transactionaldirectory.cpp \
     fileio/transactionalfilesystem.cpp \
     fileio/versionfile.cpp \
@@ -204,10 +205,12 @@ HEADERS += \
     fileio/filepath.h \
     fileio/filesystem.h \
     fileio/fileutils.h \
+    fileio/fileview.h \
     fileio/serializablekeyvaluemap.h \
     fileio/serializableobject.h \
     fileio/serializableobjectlist.h \
     fileio/sexpression.h \
+    fileio/sexpressioncache.h \
     fileio/transactionaldirectory.h \
     fileio/transactionalfilesystem.h \
     fileio/versionfile.h \
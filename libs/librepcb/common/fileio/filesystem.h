@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "filepath.h"
+#include "fileview.h"
 
 #include <QtCore>
 
@@ -54,6 +55,7 @@ public:
   virtual QStringList getFiles(const QString& path = "") const noexcept     = 0;
   virtual bool        fileExists(const QString& path) const noexcept        = 0;
   virtual QByteArray  read(const QString& path) const                       = 0;
+  virtual FileView    readView(const QString& path) const                   = 0;
   virtual void        write(const QString& path, const QByteArray& content) = 0;
   virtual void        removeFile(const QString& path)                       = 0;
   virtual void        removeDirRecursively(const QString& path = "")        = 0;
@@ -0,0 +1,116 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "fileview.h"
+
+#include "../exceptions.h"
+#include "filepath.h"
+
+#include <QtCore>
+
+#include <limits>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+FileView::FileView() noexcept : mFile(), mContent() {
+}
+
+FileView::FileView(const FileView& other) noexcept
+  : mFile(other.mFile), mContent(other.mContent) {
+}
+
+FileView::FileView(const QByteArray& content) noexcept
+  : mFile(), mContent(content) {
+}
+
+FileView::~FileView() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QByteArray FileView::toByteArray() const noexcept {
+  if (mFile) {
+    return QByteArray(mContent.constData(), mContent.size());  // deep copy
+  } else {
+    return mContent;  // implicitly shared
+  }
+}
+
+/*******************************************************************************
+ *  Operator Overloadings
+ ******************************************************************************/
+
+FileView& FileView::operator=(const FileView& rhs) noexcept {
+  // release the raw data before the mapping it points to
+  mContent = rhs.mContent;
+  mFile    = rhs.mFile;
+  return *this;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+FileView FileView::map(const FilePath& filepath) {
+  if (!filepath.isExistingFile()) {
+    throw LogicError(__FILE__, __LINE__,
+                     QString(tr("The file \"%1\" does not exist."))
+                         .arg(filepath.toNative()));
+  }
+  std::shared_ptr<QFile> file = std::make_shared<QFile>(filepath.toStr());
+  if (!file->open(QIODevice::ReadOnly)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Cannot open file \"%1\": %2"))
+                           .arg(filepath.toNative(), file->errorString()));
+  }
+
+  // Mapping fails for empty files and is not supported on all file systems,
+  // so read the file into memory in that case.
+  qint64 size = file->size();
+  uchar* data = (size > 0) && (size <= std::numeric_limits<int>::max())
+                    ? file->map(0, size)
+                    : nullptr;
+  FileView view;
+  if (data) {
+    view.mFile    = file;
+    view.mContent = QByteArray::fromRawData(reinterpret_cast<const char*>(data),
+                                            static_cast<int>(size));
+  } else {
+    view.mContent = file->readAll();
+  }
+  return view;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,118 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_FILEVIEW_H
+#define LIBREPCB_FILEVIEW_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class FilePath;
+
+/*******************************************************************************
+ *  Class FileView
+ ******************************************************************************/
+
+/**
+ * @brief Read-only view to the content of a file
+ *
+ * Files on the disk are memory-mapped with #map() to avoid copying their
+ * content into the heap. If mapping is not possible (e.g. for empty files or
+ * unsupported file systems), the file is read into memory instead. A view can
+ * also be constructed from a byte array, e.g. for files held in memory by
+ * ::librepcb::TransactionalFileSystem, which does not copy the data either.
+ *
+ * Copies of a view share the same mapping, which is released when the last
+ * copy is destroyed. Views should be kept only for a short time (e.g. while
+ * parsing the file) since a mapped file might not be replaceable on some
+ * platforms.
+ */
+class FileView final {
+  Q_DECLARE_TR_FUNCTIONS(FileView)
+
+public:
+  // Constructors / Destructor
+  FileView() noexcept;
+  FileView(const FileView& other) noexcept;
+  explicit FileView(const QByteArray& content) noexcept;
+  ~FileView() noexcept;
+
+  // Getters
+  bool isMapped() const noexcept { return mFile != nullptr; }
+  int  getSize() const noexcept { return mContent.size(); }
+
+  /**
+   * @brief Get the file content without copying it
+   *
+   * @warning If the file is mapped, the returned byte array does not own its
+   *          data, so it must not be used after this view (and all of its
+   *          copies) has been destroyed. Use #toByteArray() to keep the
+   *          content for a longer time.
+   *
+   * @return The file content
+   */
+  const QByteArray& getContent() const noexcept { return mContent; }
+
+  // General Methods
+
+  /**
+   * @brief Get the file content as a byte array which owns its data
+   *
+   * @return The file content (only copied if the file is mapped)
+   */
+  QByteArray toByteArray() const noexcept;
+
+  // Operator Overloadings
+  FileView& operator=(const FileView& rhs) noexcept;
+
+  // Static Methods
+
+  /**
+   * @brief Open a file on the disk and memory-map its content
+   *
+   * @param filepath  The file to open
+   *
+   * @return A view to the file content
+   *
+   * @throw Exception if the file could not be opened or read
+   */
+  static FileView map(const FilePath& filepath);
+
+private:  // Data
+  // Note: mContent must be declared after mFile to be destroyed before it.
+  std::shared_ptr<QFile> mFile;     ///< Owner of the mapping (if mapped)
+  QByteArray             mContent;  ///< Raw data if mapped, otherwise owned
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_FILEVIEW_H
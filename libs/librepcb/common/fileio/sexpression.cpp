@@ -22,8 +22,6 @@
  ******************************************************************************/
 #include "sexpression.h"
 
-#include <sexpresso/sexpresso.hpp>
-
 #include <QtCore>
 
 /*******************************************************************************
@@ -31,6 +29,272 @@
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Class SExpression::Parser
+ ******************************************************************************/
+
+/**
+ * @brief Single-pass parser creating an ::librepcb::SExpression tree directly
+ *        from the raw (UTF-8 encoded) file content
+ *
+ * Only string values are decoded, everything else is processed on the raw
+ * bytes. Unquoted values are stored as strings as well since the parser
+ * doesn't validate tokens.
+ *
+ * Optionally, only the child lists of the root node with the given names are
+ * parsed. All other child lists are skipped without creating any nodes.
+ */
+class SExpression::Parser final {
+public:
+  Parser(const QByteArray& content, const FilePath& filePath,
+         const QSet<QString>* rootChildren = nullptr) noexcept
+    : mData(content.constData()),
+      mSize(content.size()),
+      mPos(0),
+      mLine(1),
+      mLineStart(0),
+      mFilePath(filePath),
+      mRootChildren(rootChildren) {}
+
+  SExpression parseRoot() {
+    skipWhitespaces();
+    if (atEnd()) {
+      throw error(tr("File does not have exactly one root node."));
+    }
+    SExpression root;
+    if (mData[mPos] == '(') {
+      root = parseList(mRootChildren != nullptr);  // can throw
+    } else {
+      root = parseNode();  // can throw
+    }
+    skipWhitespaces();
+    if (!atEnd()) {
+      throw error(tr("File does not have exactly one root node."));
+    }
+    return root;
+  }
+
+private:
+  bool atEnd() const noexcept { return mPos >= mSize; }
+  int  column() const noexcept { return mPos - mLineStart + 1; }
+
+  static bool isWhitespace(char c) noexcept {
+    return (c == ' ') || (c == '\n') || (c == '\r') || (c == '\t') ||
+           (c == '\v') || (c == '\f');
+  }
+
+  void skipWhitespaces() noexcept {
+    bool comment = false;
+    while (!atEnd()) {
+      char c = mData[mPos];
+      if (c == '\n') {
+        ++mLine;
+        mLineStart = mPos + 1;
+        comment    = false;
+      } else if (c == ';') {
+        comment = true;  // comments reach until the end of the line
+      } else if ((!comment) && (!isWhitespace(c))) {
+        break;
+      }
+      ++mPos;
+    }
+  }
+
+  SExpression parseNode() {
+    switch (mData[mPos]) {
+      case '(':
+        return parseList();  // can throw
+      case ')':
+        throw error(tr("Unexpected closing parenthesis."));
+      case '"':
+        return createNode(Type::String, parseString());  // can throw
+      default:
+        return createNode(Type::String, parseToken());
+    }
+  }
+
+  SExpression parseList(bool filterChildren = false) {
+    int line   = mLine;
+    int column = this->column();
+    ++mPos;  // skip '('
+    skipWhitespaces();
+    if (atEnd() || (mData[mPos] == '(') || (mData[mPos] == ')')) {
+      throw error(tr("List without name."));
+    }
+    QString name =
+        (mData[mPos] == '"') ? parseString() : parseToken();  // can throw
+    SExpression list = createNode(Type::List, name);
+    while (true) {
+      skipWhitespaces();
+      if (atEnd()) {
+        throw error(tr("List not closed: %1").arg(name), line, column);
+      } else if (mData[mPos] == ')') {
+        ++mPos;
+        return list;
+      } else if (filterChildren && (mData[mPos] == '(') &&
+                 (!mRootChildren->contains(peekListName()))) {
+        skipList();  // can throw
+      } else {
+        list.mChildren.append(parseNode());  // can throw
+      }
+    }
+  }
+
+  QString peekListName() {
+    int pos       = mPos;
+    int line      = mLine;
+    int lineStart = mLineStart;
+    ++mPos;  // skip '('
+    skipWhitespaces();
+    QString name;
+    if ((!atEnd()) && (mData[mPos] != '(') && (mData[mPos] != ')')) {
+      name = (mData[mPos] == '"') ? parseString() : parseToken();  // can throw
+    }
+    mPos       = pos;
+    mLine      = line;
+    mLineStart = lineStart;
+    return name;
+  }
+
+  void skipList() {
+    int  line    = mLine;
+    int  column  = this->column();
+    int  depth   = 0;
+    bool comment = false;
+    bool string  = false;
+    while (!atEnd()) {
+      char c = mData[mPos];
+      if (c == '\n') {
+        ++mLine;
+        mLineStart = mPos + 1;
+        comment    = false;
+      } else if (comment) {
+        // ignore everything until the end of the line
+      } else if (string) {
+        if (c == '\\') {
+          ++mPos;  // skip escaped character
+        } else if (c == '"') {
+          string = false;
+        }
+      } else if (c == '"') {
+        string = true;
+      } else if (c == ';') {
+        comment = true;
+      } else if (c == '(') {
+        ++depth;
+      } else if ((c == ')') && (--depth == 0)) {
+        ++mPos;
+        return;
+      }
+      ++mPos;
+    }
+    throw error(tr("List not closed."), line, column);
+  }
+
+  QString parseToken() noexcept {
+    int start = mPos;
+    while ((!atEnd()) && (!isWhitespace(mData[mPos])) &&
+           (mData[mPos] != '(') && (mData[mPos] != ')')) {
+      ++mPos;
+    }
+    return QString::fromUtf8(mData + start, mPos - start);
+  }
+
+  QString parseString() {
+    int line   = mLine;
+    int column = this->column();
+    ++mPos;  // skip opening '"'
+    // Strings without escape sequences (the most common case) are decoded
+    // directly from the file content without any intermediate copy.
+    QByteArray unescaped;
+    bool       escaped = false;
+    int        start   = mPos;
+    while (true) {
+      if (atEnd()) {
+        throw error(tr("String not terminated."), line, column);
+      }
+      char c = mData[mPos];
+      if (c == '"') {
+        break;
+      } else if (c == '\\') {
+        unescaped.append(mData + start, mPos - start);
+        escaped = true;
+        ++mPos;
+        char replacement = atEnd() ? '\0' : unescape(mData[mPos]);
+        if (replacement == '\0') {
+          throw error(tr("Invalid escape sequence."));
+        }
+        unescaped.append(replacement);
+        start = mPos + 1;
+      } else if (c == '\n') {
+        ++mLine;
+        mLineStart = mPos + 1;
+      }
+      ++mPos;
+    }
+    QString value;
+    if (escaped) {
+      unescaped.append(mData + start, mPos - start);
+      value = QString::fromUtf8(unescaped);
+    } else {
+      value = QString::fromUtf8(mData + start, mPos - start);
+    }
+    ++mPos;  // skip closing '"'
+    return value;
+  }
+
+  static char unescape(char c) noexcept {
+    switch (c) {
+      case '\'':
+      case '"':
+      case '?':
+      case '\\':
+        return c;
+      case 'a':
+        return '\a';
+      case 'b':
+        return '\b';
+      case 'f':
+        return '\f';
+      case 'n':
+        return '\n';
+      case 'r':
+        return '\r';
+      case 't':
+        return '\t';
+      case 'v':
+        return '\v';
+      default:
+        return '\0';
+    }
+  }
+
+  SExpression createNode(Type type, const QString& value) const noexcept {
+    SExpression node(type, value);
+    node.mFilePath = mFilePath;
+    return node;
+  }
+
+  FileParseError error(const QString& msg) const noexcept {
+    return error(msg, mLine, column());
+  }
+
+  FileParseError error(const QString& msg, int line, int column) const
+      noexcept {
+    return FileParseError(__FILE__, __LINE__, mFilePath, line, column,
+                          QString(), msg);
+  }
+
+private:  // Data
+  const char*          mData;
+  int                  mSize;
+  int                  mPos;        ///< Current position in #mData
+  int                  mLine;       ///< Current line number (starting at 1)
+  int                  mLineStart;  ///< Position in #mData where #mLine starts
+  const FilePath&      mFilePath;
+  const QSet<QString>* mRootChildren;  ///< Root child lists to parse, or all
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -49,30 +313,6 @@ SExpression::SExpression(const SExpression& other) noexcept
     mFilePath(other.mFilePath) {
 }
 
-SExpression::SExpression(sexpresso::Sexp& sexp, const FilePath& filePath)
-  : mType(Type::List), mValue(), mFilePath(filePath) {
-  if (sexp.childCount() < 1) {
-    throw RuntimeError(__FILE__, __LINE__);
-  }
-
-  if (sexp.isSexp()) {
-    sexpresso::Sexp& first = sexp.getChild(0);
-    if (!first.isString()) {
-      throw RuntimeError(__FILE__, __LINE__);
-    }
-    mValue = QString::fromStdString(first.getString());
-    for (auto&& arg : sexp.arguments()) {
-      mChildren.append(SExpression(arg, filePath));
-    }
-  } else if (sexp.isString()) {
-    mValue = QString::fromStdString(sexp.getString());
-    mType  = Type::String;
-  } else {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
-                         tr("Unknown node type."));
-  }
-}
-
 SExpression::~SExpression() noexcept {
 }
 
@@ -110,12 +350,13 @@ const QString& SExpression::getStringOrToken(bool throwIfEmpty) const {
   return mValue;
 }
 
-QList<SExpression> SExpression::getChildren(const QString& name) const
+SExpression::ChildRefs SExpression::getChildren(const QString& name) const
     noexcept {
-  QList<SExpression> children;
-  foreach (const SExpression& child, mChildren) {
+  // Only references are collected, the children are not copied
+  ChildRefs children;
+  for (const SExpression& child : mChildren) {
     if (child.isList() && (child.mValue == name)) {
-      children.append(child);
+      children.append(std::cref(child));
     }
   }
   return children;
@@ -133,16 +374,19 @@ const SExpression* SExpression::tryGetChildByPath(const QString& path) const
     noexcept {
   const SExpression* child = this;
   foreach (const QString& name, path.split('/')) {
-    bool found = false;
-    foreach (const SExpression& childchild, child->mChildren) {
+    // if there are multiple children with the same name, the last one is used
+    const SExpression* found = nullptr;
+    for (int i = child->mChildren.count() - 1; i >= 0; --i) {
+      const SExpression& childchild = child->mChildren.at(i);
       if (childchild.isList() && (childchild.mValue == name)) {
-        child = &childchild;
-        found = true;
+        found = &childchild;
+        break;
       }
     }
     if (!found) {
       return nullptr;
     }
+    child = found;
   }
   return child;
 }
@@ -190,9 +434,19 @@ void SExpression::removeLineBreaks() noexcept {
 }
 
 QByteArray SExpression::toByteArray() const {
-  QString str = toString(0);  // can throw
-  str += '\n';                // newline at end of file
-  return str.toUtf8();
+  QByteArray output;
+  output.reserve(4096);
+  serialize(output, 0);  // can throw
+  output.append('\n');   // newline at end of file
+  return output;
+}
+
+QByteArray SExpression::toBinary() const noexcept {
+  QByteArray  output;
+  QDataStream stream(&output, QIODevice::WriteOnly);
+  stream.setVersion(QDataStream::Qt_5_2);
+  writeBinary(stream);
+  return output;
 }
 
 /*******************************************************************************
@@ -211,30 +465,45 @@ SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
  *  Private Methods
  ******************************************************************************/
 
-QString SExpression::escapeString(const QString& string) const noexcept {
-  return QString::fromStdString(sexpresso::escape(string.toStdString()));
-}
-
-bool SExpression::isValidListName(const QString& name) const noexcept {
-  return QRegExp("[a-z][a-z0-9_]*").exactMatch(name);
-}
-
-bool SExpression::isValidToken(const QString& token) const noexcept {
-  return QRegExp("[a-zA-Z0-9\\.:_-]+").exactMatch(token);
+/**
+ * @brief Write this node and all its children in the format read by
+ *        #readBinary()
+ *
+ * @param stream  The stream to write to
+ */
+void SExpression::writeBinary(QDataStream& stream) const noexcept {
+  stream << static_cast<quint8>(mType) << mValue
+         << static_cast<quint32>(mChildren.count());
+  foreach (const SExpression& child, mChildren) {
+    child.writeBinary(stream);
+  }
 }
 
-QString SExpression::toString(int indent) const {
+/**
+ * @brief Append the UTF-8 representation of this node to a buffer
+ *
+ * @param output  The buffer to append to
+ * @param indent  The indentation level of this node
+ *
+ * @return Whether the written node spans multiple lines
+ *
+ * @throw LogicError  If the tree contains invalid list names or tokens
+ */
+bool SExpression::serialize(QByteArray& output, int indent) const {
   if (mType == Type::List) {
     if (!isValidListName(mValue)) {
       throw LogicError(
           __FILE__, __LINE__,
           QString(tr("Invalid S-Expression list name: %1")).arg(mValue));
     }
-    QString str = '(' + mValue;
+    bool multiLine = false;
+    output.append('(');
+    output.append(mValue.toLatin1());  // validated to be ASCII
     for (int i = 0; i < mChildren.count(); ++i) {
-      const SExpression& child = mChildren.at(i);
-      if ((!str.at(str.length() - 1).isSpace()) && (!child.isLineBreak())) {
-        str += ' ';
+      const SExpression& child    = mChildren.at(i);
+      char               lastChar = output.at(output.size() - 1);
+      if ((lastChar != ' ') && (lastChar != '\n') && (!child.isLineBreak())) {
+        output.append(' ');
       }
       bool nextChildIsLineBreak = (i < mChildren.count() - 1)
                                       ? mChildren.at(i + 1).isLineBreak()
@@ -243,32 +512,119 @@ QString SExpression::toString(int indent) const {
         if ((i > 0) && mChildren.at(i - 1).isLineBreak()) {
           // too many line breaks ;)
         } else {
-          str += '\n';
+          output.append('\n');
         }
+        multiLine = true;
       } else {
-        str += child.toString(indent + 1);
+        multiLine |= child.serialize(output, indent + 1);  // can throw
       }
     }
-    if (isMultiLineList()) {
-      str += '\n' + QString(' ').repeated(indent);
+    if (multiLine) {
+      output.append('\n');
+      appendIndentation(output, indent);
     }
-    return str + ')';
+    output.append(')');
+    return multiLine;
   } else if (mType == Type::Token) {
     if (!isValidToken(mValue)) {
       throw LogicError(
           __FILE__, __LINE__,
           QString(tr("Invalid S-Expression token: %1")).arg(mValue));
     }
-    return mValue;
+    output.append(mValue.toLatin1());  // validated to be ASCII
+    return false;
   } else if (mType == Type::String) {
-    return '"' + escapeString(mValue) + '"';
+    output.append('"');
+    appendEscapedString(output, mValue);
+    output.append('"');
+    return false;
   } else if (mType == Type::LineBreak) {
-    return '\n' + QString(' ').repeated(indent);
+    output.append('\n');
+    appendIndentation(output, indent);
+    return true;
   } else {
     throw LogicError(__FILE__, __LINE__);
   }
 }
 
+void SExpression::appendIndentation(QByteArray& output, int indent) noexcept {
+  for (int i = 0; i < indent; ++i) {
+    output.append(' ');
+  }
+}
+
+void SExpression::appendEscapedString(QByteArray&    output,
+                                      const QString& string) noexcept {
+  // All escaped characters are ASCII, so they can be escaped in the UTF-8
+  // encoded string without decoding it.
+  QByteArray utf8 = string.toUtf8();
+  int        start = 0;
+  for (int i = 0; i < utf8.size(); ++i) {
+    char replacement;
+    switch (utf8.at(i)) {
+      case '"':
+        replacement = '"';
+        break;
+      case '\\':
+        replacement = '\\';
+        break;
+      case '\b':
+        replacement = 'b';
+        break;
+      case '\f':
+        replacement = 'f';
+        break;
+      case '\n':
+        replacement = 'n';
+        break;
+      case '\r':
+        replacement = 'r';
+        break;
+      case '\t':
+        replacement = 't';
+        break;
+      case '\v':
+        replacement = 'v';
+        break;
+      default:
+        continue;
+    }
+    output.append(utf8.constData() + start, i - start);
+    output.append('\\');
+    output.append(replacement);
+    start = i + 1;
+  }
+  output.append(utf8.constData() + start, utf8.size() - start);
+}
+
+bool SExpression::isValidListName(const QString& name) noexcept {
+  // equivalent to the regex "[a-z][a-z0-9_]*"
+  if (name.isEmpty() || (name.at(0) < 'a') || (name.at(0) > 'z')) {
+    return false;
+  }
+  foreach (const QChar& c, name) {
+    if (((c < 'a') || (c > 'z')) && ((c < '0') || (c > '9')) && (c != '_')) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SExpression::isValidToken(const QString& token) noexcept {
+  // equivalent to the regex "[a-zA-Z0-9\\.:_-]+"
+  if (token.isEmpty()) {
+    return false;
+  }
+  foreach (const QChar& c, token) {
+    if (((c < 'a') || (c > 'z')) && ((c < 'A') || (c > 'Z')) &&
+        ((c < '0') || (c > '9')) && (c != '.') && (c != ':') && (c != '_') &&
+        (c != '-')) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -291,20 +647,72 @@ SExpression SExpression::createLineBreak() {
 
 SExpression SExpression::parse(const QByteArray& content,
                                const FilePath&   filePath) {
-  std::string     error;
-  QString         str  = QString::fromUtf8(content);
-  sexpresso::Sexp tree = sexpresso::parse(str.toStdString(), error);
-  if (error.empty()) {
-    if (tree.childCount() == 1) {
-      return SExpression(tree.getChild(0), filePath);
-    } else {
-      throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                           tr("File does not have exactly one root node."));
-    }
-  } else {
-    throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                         QString::fromStdString(error));
+  return Parser(content, filePath).parseRoot();  // can throw
+}
+
+/**
+ * @brief Parse only some child lists of the root node
+ *
+ * This is much faster than #parse() if only a few attributes of a large file
+ * are needed, since all other child lists are skipped without creating any
+ * nodes. Child nodes of the root which are not lists are always parsed.
+ *
+ * @param content       The file content
+ * @param filePath      The file path (for error messages)
+ * @param rootChildren  Names of the child lists of the root node to parse
+ *
+ * @return The (partial) tree
+ *
+ * @throw FileParseError  If the content is not valid
+ */
+SExpression SExpression::parsePartially(const QByteArray&    content,
+                                        const FilePath&      filePath,
+                                        const QSet<QString>& rootChildren) {
+  return Parser(content, filePath, &rootChildren).parseRoot();  // can throw
+}
+
+/**
+ * @brief Restore a tree previously serialized with #toBinary()
+ *
+ * @param data      The binary data
+ * @param filePath  The file path to assign to all nodes
+ *
+ * @return The restored tree
+ *
+ * @throw RuntimeError  If the data is corrupt
+ */
+SExpression SExpression::fromBinary(const QByteArray& data,
+                                    const FilePath&   filePath) {
+  QDataStream stream(data);
+  stream.setVersion(QDataStream::Qt_5_2);
+  SExpression root = readBinary(stream, filePath);  // can throw
+  if (!stream.atEnd()) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Invalid binary S-Expression data."));
+  }
+  return root;
+}
+
+SExpression SExpression::readBinary(QDataStream&    stream,
+                                    const FilePath& filePath) {
+  quint8  type  = 0;
+  quint32 count = 0;
+  QString value;
+  stream >> type >> value >> count;
+  // Each child needs at least 9 bytes, which limits the count of corrupt data.
+  if ((stream.status() != QDataStream::Ok) ||
+      (type > static_cast<quint8>(Type::LineBreak)) ||
+      (count > stream.device()->bytesAvailable() / 9)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Invalid binary S-Expression data."));
+  }
+  SExpression node(static_cast<Type>(type), value);
+  node.mFilePath = filePath;
+  node.mChildren.reserve(count);
+  for (quint32 i = 0; i < count; ++i) {
+    node.mChildren.append(readBinary(stream, filePath));  // can throw
   }
+  return node;
 }
 
 /*******************************************************************************
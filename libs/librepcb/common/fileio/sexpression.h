@@ -29,13 +29,11 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
-namespace sexpresso {
-struct Sexp;
-}
-
 namespace librepcb {
 
 class SExpression;
@@ -66,6 +64,9 @@ public:
     LineBreak,  ///< manual line break inside a List
   };
 
+  /// References to child nodes, valid as long as the parent is not modified
+  typedef QVector<std::reference_wrapper<const SExpression>> ChildRefs;
+
   // Constructors / Destructor
   SExpression() noexcept;
   SExpression(const SExpression& other) noexcept;
@@ -82,7 +83,7 @@ public:
   const QString&            getName() const;
   const QString&            getStringOrToken(bool throwIfEmpty = false) const;
   const QList<SExpression>& getChildren() const { return mChildren; }
-  QList<SExpression>        getChildren(const QString& name) const noexcept;
+  ChildRefs                 getChildren(const QString& name) const noexcept;
   const SExpression&        getChildByIndex(int index) const;
   const SExpression* tryGetChildByPath(const QString& path) const noexcept;
   const SExpression& getChildByPath(const QString& path) const;
@@ -127,6 +128,7 @@ public:
   }
   void       removeLineBreaks() noexcept;
   QByteArray toByteArray() const;
+  QByteArray toBinary() const noexcept;
 
   // Operator Overloadings
   SExpression& operator=(const SExpression& rhs) noexcept;
@@ -137,15 +139,26 @@ public:
   static SExpression createString(const QString& string);
   static SExpression createLineBreak();
   static SExpression parse(const QByteArray& content, const FilePath& filePath);
+  static SExpression parsePartially(const QByteArray&    content,
+                                    const FilePath&      filePath,
+                                    const QSet<QString>& rootChildren);
+  static SExpression fromBinary(const QByteArray& data,
+                                const FilePath&   filePath);
+
+private:  // Types
+  class Parser;
 
 private:  // Methods
   SExpression(Type type, const QString& value);
-  SExpression(sexpresso::Sexp& sexp, const FilePath& filePath);
 
-  QString escapeString(const QString& string) const noexcept;
-  bool    isValidListName(const QString& name) const noexcept;
-  bool    isValidToken(const QString& token) const noexcept;
-  QString toString(int indent) const;
+  bool        serialize(QByteArray& output, int indent) const;
+  void        writeBinary(QDataStream& stream) const noexcept;
+  static SExpression readBinary(QDataStream& stream, const FilePath& filePath);
+  static void appendIndentation(QByteArray& output, int indent) noexcept;
+  static void appendEscapedString(QByteArray&    output,
+                                  const QString& string) noexcept;
+  static bool isValidListName(const QString& name) noexcept;
+  static bool isValidToken(const QString& token) noexcept;
 
 private:  // Data
   Type               mType;
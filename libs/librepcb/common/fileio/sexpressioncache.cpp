@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "sexpressioncache.h"
+
+#include "fileutils.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+SExpressionCache::SExpressionCache(const FilePath& filepath) noexcept
+  : mFilePath(filepath), mModified(false) {
+  if (mFilePath.isExistingFile()) {
+    try {
+      QByteArray  content = FileUtils::readFile(mFilePath);  // can throw
+      QDataStream stream(content);
+      stream.setVersion(QDataStream::Qt_5_2);
+      stream >> mLoadedEntries;
+      if ((stream.status() != QDataStream::Ok) || (!stream.atEnd())) {
+        throw RuntimeError(__FILE__, __LINE__, tr("Invalid cache file."));
+      }
+    } catch (const Exception& e) {
+      qWarning() << "Ignoring cache file" << mFilePath.toNative() << ":"
+                 << e.getMsg();
+      mLoadedEntries.clear();
+    }
+  }
+}
+
+SExpressionCache::~SExpressionCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+SExpression SExpressionCache::parse(const QByteArray& content,
+                                    const FilePath&   filePath) {
+  QByteArray hash = QCryptographicHash::hash(content, QCryptographicHash::Sha1);
+  QByteArray data;
+  {
+    QMutexLocker locker(&mMutex);
+    data = mLoadedEntries.value(hash);
+  }
+
+  if (!data.isEmpty()) {
+    try {
+      SExpression root = SExpression::fromBinary(data, filePath);  // can throw
+
+      QMutexLocker locker(&mMutex);
+      mUsedEntries.insert(hash, data);
+      return root;
+    } catch (const Exception& e) {
+      qWarning() << "Discarding corrupt cache entry of" << filePath.toNative()
+                 << ":" << e.getMsg();
+    }
+  }
+
+  SExpression  root   = SExpression::parse(content, filePath);  // can throw
+  QByteArray   binary = root.toBinary();
+  QMutexLocker locker(&mMutex);
+  mUsedEntries.insert(hash, binary);
+  mModified = true;
+  return root;
+}
+
+void SExpressionCache::save() {
+  QMutexLocker locker(&mMutex);
+  if ((!mModified) && (mUsedEntries.count() == mLoadedEntries.count())) {
+    return;  // all entries are still valid, no need to write the file
+  }
+
+  QByteArray  content;
+  QDataStream stream(&content, QIODevice::WriteOnly);
+  stream.setVersion(QDataStream::Qt_5_2);
+  stream << mUsedEntries;
+  FileUtils::writeFile(mFilePath, content);  // can throw
+  mLoadedEntries = mUsedEntries;
+  mModified      = false;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,102 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_SEXPRESSIONCACHE_H
+#define LIBREPCB_SEXPRESSIONCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "filepath.h"
+#include "sexpression.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class SExpressionCache
+ ******************************************************************************/
+
+/**
+ * @brief Cache of parsed ::librepcb::SExpression trees in a binary format
+ *
+ * Entries are keyed by the hash of the file content they were parsed from, so
+ * the text files stay the only source of truth: As soon as a file is modified,
+ * its hash doesn't match any entry anymore and it gets parsed again. Entries
+ * which were not used since loading the cache are discarded on #save().
+ *
+ * The cache is optional, i.e. a missing or corrupt cache file is silently
+ * ignored. #parse() is thread-safe to allow parsing files in parallel.
+ */
+class SExpressionCache final {
+  Q_DECLARE_TR_FUNCTIONS(SExpressionCache)
+
+public:
+  // Constructors / Destructor
+  SExpressionCache()                              = delete;
+  SExpressionCache(const SExpressionCache& other) = delete;
+  explicit SExpressionCache(const FilePath& filepath) noexcept;
+  ~SExpressionCache() noexcept;
+
+  // Getters
+  const FilePath& getFilePath() const noexcept { return mFilePath; }
+
+  // General Methods
+
+  /**
+   * @brief Get the parsed tree of a file, from the cache if possible
+   *
+   * @param content   The file content
+   * @param filePath  The file path (for error messages)
+   *
+   * @return The parsed tree
+   *
+   * @throw Exception   If the content is not cached and could not be parsed
+   */
+  SExpression parse(const QByteArray& content, const FilePath& filePath);
+
+  /**
+   * @brief Write the cache file, if it has changed since loading it
+   *
+   * @throw Exception   If the file could not be written
+   */
+  void save();
+
+  // Operator Overloadings
+  SExpressionCache& operator=(const SExpressionCache& rhs) = delete;
+
+private:  // Data
+  FilePath                      mFilePath;
+  QMutex                        mMutex;
+  QHash<QByteArray, QByteArray> mLoadedEntries;  ///< content hash -> tree
+  QHash<QByteArray, QByteArray> mUsedEntries;    ///< content hash -> tree
+  bool                          mModified;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_SEXPRESSIONCACHE_H
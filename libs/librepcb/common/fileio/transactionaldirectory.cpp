@@ -99,6 +99,10 @@ QByteArray TransactionalDirectory::read(const QString& path) const {
   return mFileSystem->read(mPath % "/" % path);
 }
 
+FileView TransactionalDirectory::readView(const QString& path) const {
+  return mFileSystem->readView(mPath % "/" % path);
+}
+
 void TransactionalDirectory::write(const QString&    path,
                                    const QByteArray& content) {
   mFileSystem->write(mPath % "/" % path, content);
@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "transactionalfilesystem.h"
 
+#include "../scopeguard.h"
 #include "../toolbox.h"
 #include "fileutils.h"
 #include "sexpression.h"
@@ -29,12 +30,94 @@
 #include <quazip/quazip.h>
 #include <quazip/quazipdir.h>
 #include <quazip/quazipfile.h>
+#include <zlib.h>
+
+#include <QtConcurrent/QtConcurrent>
 
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Types
+ ******************************************************************************/
+
+struct CompressedZipEntry {
+  QString                    filePath;
+  QByteArray                 data;  ///< Raw deflate stream or stored content
+  qulonglong                 uncompressedSize;
+  quint32                    crc;
+  int                        method;
+  int                        level;
+  std::shared_ptr<Exception> error;  ///< Exceptions can't cross threads
+};
+
+/*******************************************************************************
+ *  Static Helpers
+ ******************************************************************************/
+
+/**
+ * @brief Check whether a file is of an already compressed format
+ *
+ * Compressing such files again would only waste time, so they are stored
+ * uncompressed in ZIP archives.
+ */
+static bool isCompressedFileFormat(const QString& filePath) noexcept {
+  static const QSet<QString> suffixes = {"7z",  "bz2", "gif", "gz", "jpeg",
+                                         "jpg", "lppz", "png", "xz", "zip"};
+  return suffixes.contains(QFileInfo(filePath).suffix().toLower());
+}
+
+/**
+ * @brief Compress a file for a ZIP archive (called in worker threads)
+ *
+ * @param filePath  Path of the file within the archive
+ * @param content   The uncompressed file content
+ * @param level     zlib compression level (0 = store only, -1 = default)
+ *
+ * @return The compressed entry, ready to be written in raw mode
+ */
+static CompressedZipEntry compressZipEntry(const QString&    filePath,
+                                           const QByteArray& content,
+                                           int               level) noexcept {
+  Bytef* input = reinterpret_cast<Bytef*>(const_cast<char*>(content.data()));
+  CompressedZipEntry entry;
+  entry.filePath         = filePath;
+  entry.uncompressedSize = content.size();
+  entry.crc              = crc32(crc32(0L, Z_NULL, 0), input, content.size());
+  entry.method           = (level == 0) ? 0 : Z_DEFLATED;
+  entry.level            = level;
+  if (entry.method == 0) {
+    entry.data = content;
+    return entry;
+  }
+
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    entry.error.reset(new RuntimeError(
+        __FILE__, __LINE__,
+        QString("Failed to initialize compression of '%1'.").arg(filePath)));
+    return entry;
+  }
+  entry.data.resize(deflateBound(&stream, content.size()));
+  stream.next_in   = input;
+  stream.avail_in  = content.size();
+  stream.next_out  = reinterpret_cast<Bytef*>(entry.data.data());
+  stream.avail_out = entry.data.size();
+  int result       = deflate(&stream, Z_FINISH);
+  deflateEnd(&stream);
+  if (result != Z_STREAM_END) {
+    entry.error.reset(new RuntimeError(
+        __FILE__, __LINE__, QString("Failed to compress '%1'.").arg(filePath)));
+    return entry;
+  }
+  entry.data.resize(stream.total_out);
+  return entry;
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -73,6 +156,10 @@ TransactionalFileSystem::TransactionalFileSystem(
 }
 
 TransactionalFileSystem::~TransactionalFileSystem() noexcept {
+  // A still running background autosave must not write into the autosave
+  // directory after it has been removed.
+  waitForAutosave();
+
   // Remove autosave directory as it is not needed in case the file system
   // was gracefully closed. We only need it if the application has crashed.
   // But if the file system is opened in read-only mode, or if an autosave was
@@ -175,10 +262,29 @@ QByteArray TransactionalFileSystem::read(const QString& path) const {
   }
 }
 
+FileView TransactionalFileSystem::readView(const QString& path) const {
+  QString cleanedPath = cleanPath(path);
+  if (mModifiedFiles.contains(cleanedPath)) {
+    return FileView(mModifiedFiles.value(cleanedPath));
+  } else if (!isRemoved(cleanedPath)) {
+    return FileView::map(mFilePath.getPathTo(cleanedPath));  // can throw
+  } else {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("File '%1' does not exist."))
+                           .arg(mFilePath.getPathTo(cleanedPath).toNative()));
+  }
+}
+
 void TransactionalFileSystem::write(const QString&    path,
                                     const QByteArray& content) {
-  QString cleanedPath         = cleanPath(path);
-  mModifiedFiles[cleanedPath] = content;
+  QString cleanedPath = cleanPath(path);
+  if ((!isRemoved(cleanedPath)) && isEqualToFileOnDisk(cleanedPath, content)) {
+    // Nothing to save (anymore), which keeps the backup and autosave diffs
+    // small if most files are written again without any changes.
+    mModifiedFiles.remove(cleanedPath);
+  } else {
+    mModifiedFiles[cleanedPath] = content;
+  }
   mRemovedFiles.remove(cleanedPath);
 }
 
@@ -224,16 +330,83 @@ void TransactionalFileSystem::loadFromZip(const FilePath& fp) {
   zip.close();
 }
 
-void TransactionalFileSystem::exportToZip(const FilePath& fp) const {
+/**
+ * @brief Export all files of the file system to a ZIP file
+ *
+ * The files are compressed in parallel in worker threads, while the
+ * compressed data is written sequentially into the archive. Files of formats
+ * which are already compressed (e.g. images) are always stored uncompressed.
+ *
+ * @param fp                The ZIP file to create
+ * @param compressionLevel  zlib compression level from 0 (store only) to 9,
+ *                          or -1 for the default level
+ *
+ * @throw Exception on errors
+ */
+void TransactionalFileSystem::exportToZip(const FilePath& fp,
+                                          int compressionLevel) const {
+  QElapsedTimer timer;
+  timer.start();
+
+  // Start compressing all files in worker threads. Reading the files is done
+  // in the worker threads too, since this object is not modified meanwhile.
+  QStringList files;
+  getFilesToExport(files, fp, "");
+  QList<QFuture<CompressedZipEntry>> futures;
+  auto                               sg = scopeGuard([&futures]() {
+    // the workers access this object, so wait for them in any case
+    foreach (QFuture<CompressedZipEntry> future, futures) {
+      future.waitForFinished();
+    }
+  });
+  foreach (const QString& filepath, files) {
+    int level = isCompressedFileFormat(filepath) ? 0 : compressionLevel;
+    futures.append(QtConcurrent::run([this, filepath, level]() {
+      try {
+        return compressZipEntry(filepath, read(filepath), level);  // can throw
+      } catch (const Exception& e) {
+        CompressedZipEntry entry;
+        entry.error.reset(e.clone());
+        return entry;
+      }
+    }));
+  }
+
   QuaZip zip(fp.toStr());
   if (!zip.open(QuaZip::mdCreate)) {
     throw RuntimeError(
         __FILE__, __LINE__,
         QString(tr("Failed to create the ZIP file '%1'.")).arg(fp.toNative()));
   }
+  qulonglong totalSize = 0;
   try {
+    // Write the compressed files in the original order into the archive.
     QuaZipFile file(&zip);
-    exportDirToZip(file, fp, "");
+    for (int i = 0; i < futures.count(); ++i) {
+      CompressedZipEntry entry = futures[i].result();  // blocks
+      if (entry.error) {
+        entry.error->raise();
+      }
+      QuaZipNewInfo newFileInfo(entry.filePath);
+      newFileInfo.uncompressedSize = entry.uncompressedSize;
+      newFileInfo.setPermissions(QFileDevice::ReadOwner |
+                                 QFileDevice::ReadGroup |
+                                 QFileDevice::ReadOther |
+                                 QFileDevice::WriteOwner);
+      if (!file.open(QIODevice::WriteOnly, newFileInfo, nullptr, entry.crc,
+                     entry.method, entry.level, true)) {
+        throw RuntimeError(__FILE__, __LINE__);
+      }
+      qint64 bytesWritten = file.write(entry.data);
+      file.close();
+      if ((bytesWritten != entry.data.length()) ||
+          (file.getZipError() != UNZ_OK)) {
+        throw RuntimeError(__FILE__, __LINE__,
+                           QString(tr("Failed to write file '%1' to '%2'."))
+                               .arg(entry.filePath, fp.toNative()));
+      }
+      totalSize += entry.uncompressedSize;
+    }
     zip.close();
   } catch (const Exception& e) {
     // Remove ZIP file because it is not complete
@@ -241,6 +414,11 @@ void TransactionalFileSystem::exportToZip(const FilePath& fp) const {
     zip.close();
     throw;
   }
+
+  qint64 ms = qMax(timer.elapsed(), qint64(1));
+  qDebug() << "Exported" << futures.count() << "files ("
+           << (totalSize / 1024) << "kB ) to ZIP in" << ms << "ms ("
+           << ((totalSize * 1000) / (ms * 1024 * 1024)) << "MB/s )";
 }
 
 void TransactionalFileSystem::discardChanges() noexcept {
@@ -282,10 +460,48 @@ QStringList TransactionalFileSystem::checkForModifications() const {
 }
 
 void TransactionalFileSystem::autosave() {
+  waitForAutosave();
   saveDiff("autosave");  // can throw
 }
 
+bool TransactionalFileSystem::startAutosave() {
+  if (!mIsWritable) {
+    throw RuntimeError(__FILE__, __LINE__, tr("File system is read-only."));
+  }
+
+  // If the previous autosave is still running, skip this one. The next
+  // autosave will contain all modifications anyway.
+  if (mAutosaveFuture.isRunning()) {
+    return false;
+  }
+
+  // The containers are implicitly shared, so these copies are very cheap.
+  // Modifications made while the autosave is running will detach the member
+  // containers and thus do not affect the snapshot.
+  FilePath                   root         = mFilePath;
+  QHash<QString, QByteArray> modified     = mModifiedFiles;
+  QSet<QString>              removedFiles = mRemovedFiles;
+  QSet<QString>              removedDirs  = mRemovedDirs;
+  mAutosaveFuture = QtConcurrent::run([=]() {
+    try {
+      writeDiff(root, "autosave", modified, removedFiles,
+                removedDirs);  // can throw
+      qDebug() << "Background autosave finished:" << root.toNative();
+    } catch (const Exception& e) {
+      qCritical() << "Background autosave failed:" << e.getMsg();
+    }
+  });
+  return true;
+}
+
+void TransactionalFileSystem::waitForAutosave() noexcept {
+  mAutosaveFuture.waitForFinished();
+}
+
 void TransactionalFileSystem::save() {
+  // make sure a running background autosave does not interfere with saving
+  waitForAutosave();
+
   // save to backup directory
   saveDiff("backup");  // can throw
 
@@ -356,16 +572,30 @@ bool TransactionalFileSystem::isRemoved(const QString& path) const noexcept {
   return false;
 }
 
-void TransactionalFileSystem::exportDirToZip(QuaZipFile&     file,
-                                             const FilePath& zipFp,
-                                             const QString&  dir) const {
+bool TransactionalFileSystem::isEqualToFileOnDisk(
+    const QString& path, const QByteArray& content) const noexcept {
+  FilePath  fp = mFilePath.getPathTo(path);
+  QFileInfo info(fp.toStr());
+  if ((!info.isFile()) || (info.size() != content.size())) {
+    return false;  // avoid reading the file if possible
+  }
+  try {
+    return FileUtils::readFile(fp) == content;  // can throw
+  } catch (const Exception&) {
+    return false;
+  }
+}
+
+void TransactionalFileSystem::getFilesToExport(QStringList&    files,
+                                               const FilePath& zipFp,
+                                               const QString&  dir) const {
   QString path = dir.isEmpty() ? dir : dir % "/";
 
   // export directories
   foreach (const QString& dirname, getDirs(dir)) {
     // skip dotdirs, e.g. ".git", ".svn", ".autosave", ".backup"
     if (dirname.startsWith('.')) continue;
-    exportDirToZip(file, zipFp, path % dirname);
+    getFilesToExport(files, zipFp, path % dirname);
   }
 
   // export files
@@ -378,53 +608,17 @@ void TransactionalFileSystem::exportDirToZip(QuaZipFile&     file,
     }
     // skip lock file
     if (filename == ".lock") continue;
-    // read file content and add it to the ZIP archive
-    const QByteArray& content = read(filepath);  // can throw
-    QuaZipNewInfo     newFileInfo(filepath);
-    newFileInfo.setPermissions(QFileDevice::ReadOwner | QFileDevice::ReadGroup |
-                               QFileDevice::ReadOther |
-                               QFileDevice::WriteOwner);
-    if (!file.open(QIODevice::WriteOnly, newFileInfo)) {
-      throw RuntimeError(__FILE__, __LINE__);
-    }
-    qint64 bytesWritten = file.write(content);
-    file.close();
-    if (bytesWritten != content.length()) {
-      throw RuntimeError(__FILE__, __LINE__,
-                         QString(tr("Failed to write file '%1' to '%2'."))
-                             .arg(filepath, zipFp.toNative()));
-    }
+    files.append(filepath);
   }
 }
 
 void TransactionalFileSystem::saveDiff(const QString& type) const {
-  QDateTime dt       = QDateTime::currentDateTime();
-  FilePath  dir      = mFilePath.getPathTo("." % type);
-  FilePath  filesDir = dir.getPathTo(dt.toString("yyyy-MM-dd_hh-mm-ss-zzz"));
-
   if (!mIsWritable) {
     throw RuntimeError(__FILE__, __LINE__, tr("File system is read-only."));
   }
 
-  SExpression root = SExpression::createList("librepcb_" % type);
-  root.appendChild("created", dt, true);
-  root.appendChild("modified_files_directory", filesDir.getFilename(), true);
-  foreach (const QString& filepath, Toolbox::sorted(mModifiedFiles.keys())) {
-    root.appendChild("modified_file", filepath, true);
-    FileUtils::writeFile(filesDir.getPathTo(filepath),
-                         mModifiedFiles.value(filepath));  // can throw
-  }
-  foreach (const QString& filepath, Toolbox::sorted(mRemovedFiles.values())) {
-    root.appendChild("removed_file", filepath, true);
-  }
-  foreach (const QString& filepath, Toolbox::sorted(mRemovedDirs.values())) {
-    root.appendChild("removed_directory", filepath, true);
-  }
-
-  // Writing the main file must be the last operation to "mark" this diff as
-  // complete!
-  FileUtils::writeFile(dir.getPathTo(type % ".lp"),
-                       root.toByteArray());  // can throw
+  writeDiff(mFilePath, type, mModifiedFiles, mRemovedFiles,
+            mRemovedDirs);  // can throw
 }
 
 void TransactionalFileSystem::loadDiff(const FilePath& fp) {
@@ -432,12 +626,20 @@ void TransactionalFileSystem::loadDiff(const FilePath& fp) {
 
   SExpression root =
       SExpression::parse(FileUtils::readFile(fp), fp);  // can throw
-  QString modifiedFilesDirName =
-      root.getValueByPath<QString>("modified_files_directory", true);
-  FilePath modifiedFilesDir = fp.getParentDir().getPathTo(modifiedFilesDirName);
+  FilePath objectsDir = fp.getParentDir().getPathTo("objects");
   foreach (const SExpression& node, root.getChildren("modified_file")) {
     QString  relPath = node.getValueOfFirstChild<QString>(true);
-    FilePath absPath = modifiedFilesDir.getPathTo(relPath);
+    FilePath absPath;
+    if (const SExpression* hashNode = node.tryGetChildByPath("sha1")) {
+      QString hash = hashNode->getValueOfFirstChild<QString>(true);
+      absPath      = objectsDir.getPathTo(hash);
+    } else {
+      // diffs of older application versions contain a directory with copies
+      // of all modified files
+      FilePath filesDir = fp.getParentDir().getPathTo(
+          root.getValueByPath<QString>("modified_files_directory", true));
+      absPath = filesDir.getPathTo(relPath);
+    }
     mModifiedFiles.insert(relPath, FileUtils::readFile(absPath));  // can throw
   }
   foreach (const SExpression& node, root.getChildren("removed_file")) {
@@ -463,6 +665,67 @@ void TransactionalFileSystem::removeDiff(const QString& type) {
   FileUtils::removeDirRecursively(dir);  // can throw
 }
 
+void TransactionalFileSystem::writeDiff(
+    const FilePath& root, const QString& type,
+    const QHash<QString, QByteArray>& modifiedFiles,
+    const QSet<QString>& removedFiles, const QSet<QString>& removedDirs) {
+  FilePath dir        = root.getPathTo("." % type);
+  FilePath objectsDir = dir.getPathTo("objects");
+
+  // The modified files are stored by the hash of their content, so files
+  // which are already contained in a previous diff don't need to be written
+  // again. Since objects are written atomically, an existing object is always
+  // complete.
+  SExpression sexpr = SExpression::createList("librepcb_" % type);
+  sexpr.appendChild("created", QDateTime::currentDateTime(), true);
+  QSet<QString> objects;
+  foreach (const QString& filepath, Toolbox::sorted(modifiedFiles.keys())) {
+    const QByteArray& content = modifiedFiles[filepath];
+    QString           hash    = getContentHash(content);
+    sexpr.appendChild("modified_file", filepath, true)
+        .appendChild("sha1", hash, false);
+    FilePath objectFp = objectsDir.getPathTo(hash);
+    if ((!objects.contains(hash)) && (!objectFp.isExistingFile())) {
+      FileUtils::writeFile(objectFp, content);  // can throw
+    }
+    objects.insert(hash);
+  }
+  foreach (const QString& filepath, Toolbox::sorted(removedFiles.values())) {
+    sexpr.appendChild("removed_file", filepath, true);
+  }
+  foreach (const QString& filepath, Toolbox::sorted(removedDirs.values())) {
+    sexpr.appendChild("removed_directory", filepath, true);
+  }
+
+  // Writing the main file must be the last operation to "mark" this diff as
+  // complete! FileUtils::writeFile() replaces the file atomically, so a crash
+  // while writing never leaves a partial index file behind.
+  FileUtils::writeFile(dir.getPathTo(type % ".lp"),
+                       sexpr.toByteArray());  // can throw
+
+  // Now objects which are not referenced anymore can be removed. Failing to
+  // do so is not critical since the diff is already complete.
+  try {
+    if (objectsDir.isExistingDir()) {
+      foreach (const FilePath& fp,
+               FileUtils::getFilesInDirectory(objectsDir)) {  // can throw
+        if (!objects.contains(fp.getFilename())) {
+          FileUtils::removeFile(fp);  // can throw
+        }
+      }
+    }
+  } catch (const Exception& e) {
+    qWarning() << "Could not remove unused objects of" << dir.toNative() << ":"
+               << e.getMsg();
+  }
+}
+
+QString TransactionalFileSystem::getContentHash(
+    const QByteArray& content) noexcept {
+  return QString::fromLatin1(
+      QCryptographicHash::hash(content, QCryptographicHash::Sha1).toHex());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
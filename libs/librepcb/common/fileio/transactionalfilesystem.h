@@ -34,8 +34,6 @@
  *  Namespace / Forward Declarations
  ******************************************************************************/
 
-class QuaZipFile;
-
 namespace librepcb {
 
 /*******************************************************************************
@@ -55,10 +53,12 @@ namespace librepcb {
  *  - In R/W mode, it locks the accessed directory to avoid parallel usage (see
  *    @ref doc_project_lock)
  *  - Supports periodic saving to allow restoring the last autosave backup after
- *    an application crash (see @ref doc_project_autosave).
+ *    an application crash (see @ref doc_project_autosave). The autosave can
+ *    also be written in a background thread (see #startAutosave()).
  *  - Holds all file modifications in memory and allows to write those in an
  *    atomic way to the disk (see @ref doc_project_save).
- *  - Allows to export the whole file system to a ZIP file.
+ *  - Allows to export the whole file system to a ZIP file (files are
+ *    compressed in parallel, see #exportToZip()).
  */
 class TransactionalFileSystem final : public FileSystem {
   Q_OBJECT
@@ -145,16 +145,19 @@ public:
       noexcept override;
   virtual bool       fileExists(const QString& path) const noexcept override;
   virtual QByteArray read(const QString& path) const override;
+  virtual FileView   readView(const QString& path) const override;
   virtual void write(const QString& path, const QByteArray& content) override;
   virtual void removeFile(const QString& path) override;
   virtual void removeDirRecursively(const QString& path = "") override;
 
   // General Methods
   void        loadFromZip(const FilePath& fp);
-  void        exportToZip(const FilePath& fp) const;
+  void        exportToZip(const FilePath& fp, int compressionLevel = -1) const;
   void        discardChanges() noexcept;
   QStringList checkForModifications() const;
   void        autosave();
+  bool        startAutosave();
+  void        waitForAutosave() noexcept;
   void        save();
 
   // Static Methods
@@ -181,11 +184,18 @@ public:
 
 private:  // Methods
   bool isRemoved(const QString& path) const noexcept;
-  void exportDirToZip(QuaZipFile& file, const FilePath& zipFp,
-                      const QString& dir) const;
+  bool isEqualToFileOnDisk(const QString&    path,
+                           const QByteArray& content) const noexcept;
+  void getFilesToExport(QStringList& files, const FilePath& zipFp,
+                        const QString& dir) const;
   void saveDiff(const QString& type) const;
   void loadDiff(const FilePath& fp);
   void removeDiff(const QString& type);
+  static void writeDiff(const FilePath& root, const QString& type,
+                        const QHash<QString, QByteArray>& modifiedFiles,
+                        const QSet<QString>&              removedFiles,
+                        const QSet<QString>&              removedDirs);
+  static QString getContentHash(const QByteArray& content) noexcept;
 
 private:  // Data
   FilePath      mFilePath;
@@ -197,6 +207,9 @@ private:  // Data
   QHash<QString, QByteArray> mModifiedFiles;
   QSet<QString>              mRemovedFiles;
   QSet<QString>              mRemovedDirs;
+
+  // Autosave running in background (see #startAutosave())
+  QFuture<void> mAutosaveFuture;
 };
 
 /*******************************************************************************
@@ -138,6 +138,36 @@ ClipperLib::Paths ClipperHelpers::flattenTree(
   return paths;
 }
 
+ClipperLib::IntRect ClipperHelpers::getBoundingRect(
+    const ClipperLib::Paths& paths) noexcept {
+  // Note: Like ClipperLib::ClipperBase::GetBounds(), "top" is the minimum Y
+  // coordinate and "bottom" the maximum Y coordinate. For empty paths, a
+  // zero-sized rect at the origin is returned.
+  ClipperLib::IntRect rect  = {0, 0, 0, 0};
+  bool                first = true;
+  for (const ClipperLib::Path& path : paths) {
+    for (const ClipperLib::IntPoint& p : path) {
+      if (first) {
+        rect  = {p.X, p.Y, p.X, p.Y};
+        first = false;
+      } else {
+        rect.left   = std::min(rect.left, p.X);
+        rect.top    = std::min(rect.top, p.Y);
+        rect.right  = std::max(rect.right, p.X);
+        rect.bottom = std::max(rect.bottom, p.Y);
+      }
+    }
+  }
+  return rect;
+}
+
+bool ClipperHelpers::intersects(const ClipperLib::IntRect& a,
+                                const ClipperLib::IntRect& b) noexcept {
+  // Touching rects are considered as intersecting to be on the safe side.
+  return (a.left <= b.right) && (b.left <= a.right) && (a.top <= b.bottom) &&
+         (b.top <= a.bottom);
+}
+
 /*******************************************************************************
  *  Conversion Methods
  ******************************************************************************/
@@ -62,6 +62,10 @@ public:
   static void offset(ClipperLib::Paths& paths, const Length& offset,
                      const PositiveLength& maxArcTolerance);
   static ClipperLib::Paths flattenTree(const ClipperLib::PolyNode& node);
+  static ClipperLib::IntRect getBoundingRect(
+      const ClipperLib::Paths& paths) noexcept;
+  static bool intersects(const ClipperLib::IntRect& a,
+                         const ClipperLib::IntRect& b) noexcept;
 
   // Type Conversions
   static QVector<Path>     convert(const ClipperLib::Paths& paths) noexcept;
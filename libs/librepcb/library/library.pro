@@ -64,6 +64,7 @@ SOURCES += \
     libraryelement.cpp \
     libraryelementcache.cpp \
     libraryelementcheck.cpp \
+    libraryelementheader.cpp \
     msg/libraryelementcheckmessage.cpp \
     msg/msgmissingauthor.cpp \
     msg/msgmissingcategories.cpp \
@@ -148,6 +149,7 @@ HEADERS += \
     libraryelement.h \
     libraryelementcache.h \
     libraryelementcheck.h \
+    libraryelementheader.h \
     msg/libraryelementcheckmessage.h \
     msg/msgmissingauthor.h \
     msg/msgmissingcategories.h \
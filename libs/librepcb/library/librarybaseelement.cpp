@@ -76,43 +76,15 @@ LibraryBaseElement::LibraryBaseElement(
         "unknown")),  // just for initialization, will be overwritten
     mDescriptions(""),
     mKeywords("") {
-  // determine the filename of the version file
-  QString versionFileName = ".librepcb-" % mShortElementName;
-
   // check if the directory is a library element
-  if (!mDirectory->fileExists(versionFileName)) {
-    throw RuntimeError(
-        __FILE__, __LINE__,
-        QString(tr("Directory is not a library element of type %1: \"%2\""))
-            .arg(mLongElementName, mDirectory->getAbsPath().toNative()));
-  }
-
-  // check directory name
-  QString dirUuidStr = mDirectory->getAbsPath().getFilename();
-  if (mDirectoryNameMustBeUuid && (!Uuid::isValid(dirUuidStr))) {
-    throw RuntimeError(__FILE__, __LINE__,
-                       QString(tr("Directory name is not a valid UUID: \"%1\""))
-                           .arg(mDirectory->getAbsPath().toNative()));
-  }
-
-  // read version number from version file
-  VersionFile versionFile =
-      VersionFile::fromByteArray(mDirectory->read(versionFileName));
-  if (versionFile.getVersion() > qApp->getAppVersion()) {
-    throw RuntimeError(
-        __FILE__, __LINE__,
-        QString(
-            tr("The library element %1 was created with a newer application "
-               "version. You need at least LibrePCB version %2 to open it."))
-            .arg(mDirectory->getAbsPath().toNative())
-            .arg(versionFile.getVersion().toPrettyStr(3)));
-  }
+  checkElementDirectory(*mDirectory, mDirectoryNameMustBeUuid,
+                        mShortElementName, mLongElementName);  // can throw
 
   // open main file
   QString  sexprFileName = mLongElementName % ".lp";
   FilePath sexprFilePath = mDirectory->getAbsPath(sexprFileName);
-  mLoadingFileDocument =
-      SExpression::parse(mDirectory->read(sexprFileName), sexprFilePath);
+  mLoadingFileDocument = SExpression::parse(
+      mDirectory->readView(sexprFileName).getContent(), sexprFilePath);
 
   // read attributes
   mUuid         = mLoadingFileDocument.getChildByIndex(0).getValue<Uuid>();
@@ -127,6 +99,7 @@ LibraryBaseElement::LibraryBaseElement(
   mKeywords     = LocalizedKeywordsMap(mLoadingFileDocument);
 
   // check if the UUID equals to the directory basename
+  QString dirUuidStr = mDirectory->getAbsPath().getFilename();
   if (mDirectoryNameMustBeUuid && (mUuid.toStr() != dirUuidStr)) {
     qDebug() << mUuid.toStr() << "!=" << dirUuidStr;
     throw RuntimeError(
@@ -194,6 +167,44 @@ void LibraryBaseElement::moveIntoParentDirectory(TransactionalDirectory& dest) {
   moveTo(dir);  // can throw
 }
 
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+void LibraryBaseElement::checkElementDirectory(
+    const TransactionalDirectory& directory, bool dirnameMustBeUuid,
+    const QString& shortElementName, const QString& longElementName) {
+  // check if the directory is a library element
+  QString versionFileName = ".librepcb-" % shortElementName;
+  if (!directory.fileExists(versionFileName)) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        QString(tr("Directory is not a library element of type %1: \"%2\""))
+            .arg(longElementName, directory.getAbsPath().toNative()));
+  }
+
+  // check directory name
+  if (dirnameMustBeUuid &&
+      (!Uuid::isValid(directory.getAbsPath().getFilename()))) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Directory name is not a valid UUID: \"%1\""))
+                           .arg(directory.getAbsPath().toNative()));
+  }
+
+  // check version number of version file
+  VersionFile versionFile =
+      VersionFile::fromByteArray(directory.read(versionFileName));
+  if (versionFile.getVersion() > qApp->getAppVersion()) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        QString(
+            tr("The library element %1 was created with a newer application "
+               "version. You need at least LibrePCB version %2 to open it."))
+            .arg(directory.getAbsPath().toNative())
+            .arg(versionFile.getVersion().toPrettyStr(3)));
+  }
+}
+
 /*******************************************************************************
  *  Protected Methods
  ******************************************************************************/
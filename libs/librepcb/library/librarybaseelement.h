@@ -128,6 +128,19 @@ public:
                           ElementType::getShortElementName());
   }
 
+  /**
+   * @brief Check if a directory can be opened as a library element
+   *
+   * Checks the existence of the version file, the directory name (if
+   * required) and the file format version.
+   *
+   * @throw Exception if the directory is not a valid library element
+   */
+  static void checkElementDirectory(const TransactionalDirectory& directory,
+                                    bool           dirnameMustBeUuid,
+                                    const QString& shortElementName,
+                                    const QString& longElementName);
+
 protected:
   // Protected Methods
   virtual void cleanupAfterLoadingElementFromFile() noexcept;
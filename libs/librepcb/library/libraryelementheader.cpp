@@ -0,0 +1,107 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "libraryelementheader.h"
+
+#include "librarybaseelement.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace library {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+LibraryElementHeader::LibraryElementHeader(
+    const TransactionalDirectory& directory, const QString& shortElementName,
+    const QString& longElementName)
+  : mRoot(parseMainFile(directory, shortElementName, longElementName)),
+    mUuid(mRoot.getChildByIndex(0).getValue<Uuid>()),
+    mVersion(mRoot.getValueByPath<Version>("version")),
+    mNames(mRoot),
+    mDescriptions(mRoot),
+    mKeywords(mRoot),
+    mCategories() {
+  // read category UUIDs
+  foreach (const SExpression& node, mRoot.getChildren("category")) {
+    mCategories.insert(node.getValueOfFirstChild<Uuid>());
+  }
+
+  // check if the UUID equals to the directory basename
+  if (mUuid.toStr() != directory.getAbsPath().getFilename()) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        QString(
+            tr("UUID mismatch between element directory and main file: \"%1\""))
+            .arg(directory.getAbsPath(longElementName % ".lp").toNative()));
+  }
+}
+
+LibraryElementHeader::~LibraryElementHeader() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QStringList LibraryElementHeader::getAllAvailableLocales() const noexcept {
+  QStringList list;
+  list.append(mNames.keys());
+  list.append(mDescriptions.keys());
+  list.append(mKeywords.keys());
+  list.removeDuplicates();
+  list.sort(Qt::CaseSensitive);
+  return list;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+SExpression LibraryElementHeader::parseMainFile(
+    const TransactionalDirectory& directory, const QString& shortElementName,
+    const QString& longElementName) {
+  // check if the directory is a library element
+  LibraryBaseElement::checkElementDirectory(
+      directory, true, shortElementName, longElementName);  // can throw
+
+  // parse only the nodes needed for the header, skip all others
+  static const QSet<QString> nodes = {
+      "version",  "name",      "description", "keywords",
+      "category", "parent",    "component",   "package"};
+  QString sexprFileName = longElementName % ".lp";
+  return SExpression::parsePartially(
+      directory.readView(sexprFileName).getContent(),
+      directory.getAbsPath(sexprFileName), nodes);  // can throw
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace library
+}  // namespace librepcb
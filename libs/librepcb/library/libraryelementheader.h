@@ -0,0 +1,119 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_LIBRARY_LIBRARYELEMENTHEADER_H
+#define LIBREPCB_LIBRARY_LIBRARYELEMENTHEADER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/fileio/serializablekeyvaluemap.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/fileio/transactionaldirectory.h>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/version.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace library {
+
+/*******************************************************************************
+ *  Class LibraryElementHeader
+ ******************************************************************************/
+
+/**
+ * @brief Lightweight, read-only view of the metadata of a library element
+ *
+ * Loads only the attributes needed to index a library element (UUID, version,
+ * names, descriptions, keywords, categories and the references to other
+ * elements) without constructing the whole element. All other nodes of the
+ * main file (e.g. symbol graphics or footprints) are skipped by the parser,
+ * which makes it much faster than opening the element with its constructor.
+ *
+ * The directory is validated with
+ * librepcb::library::LibraryBaseElement::checkElementDirectory() like in the
+ * constructor of librepcb::library::LibraryBaseElement, so an element which
+ * can be opened as a header can also be opened normally
+ * (as long as the skipped nodes are valid). Only elements whose directory name
+ * is their UUID are supported, i.e. not librepcb::library::Library.
+ *
+ * Type-specific attributes are available through #getRoot(), e.g.
+ * `getRoot().getValueByPath<Uuid>("component")` for devices.
+ */
+class LibraryElementHeader final {
+  Q_DECLARE_TR_FUNCTIONS(LibraryElementHeader)
+
+public:
+  // Constructors / Destructor
+  LibraryElementHeader()                                  = delete;
+  LibraryElementHeader(const LibraryElementHeader& other) = default;
+  LibraryElementHeader(const TransactionalDirectory& directory,
+                       const QString&                shortElementName,
+                       const QString&                longElementName);
+  ~LibraryElementHeader() noexcept;
+
+  // Getters
+  const Uuid&             getUuid() const noexcept { return mUuid; }
+  const Version&          getVersion() const noexcept { return mVersion; }
+  const LocalizedNameMap& getNames() const noexcept { return mNames; }
+  const LocalizedDescriptionMap& getDescriptions() const noexcept {
+    return mDescriptions;
+  }
+  const LocalizedKeywordsMap& getKeywords() const noexcept { return mKeywords; }
+  QStringList                 getAllAvailableLocales() const noexcept;
+  const QSet<Uuid>& getCategories() const noexcept { return mCategories; }
+  const SExpression& getRoot() const noexcept { return mRoot; }
+
+  // Operator Overloadings
+  LibraryElementHeader& operator=(const LibraryElementHeader& rhs) = default;
+
+  // Static Methods
+  template <typename ElementType>
+  static LibraryElementHeader open(const TransactionalDirectory& directory) {
+    return LibraryElementHeader(directory, ElementType::getShortElementName(),
+                                ElementType::getLongElementName());
+  }
+
+private:  // Methods
+  static SExpression parseMainFile(const TransactionalDirectory& directory,
+                                   const QString& shortElementName,
+                                   const QString& longElementName);
+
+private:  // Data
+  SExpression             mRoot;  ///< Partially parsed main file
+  Uuid                    mUuid;
+  Version                 mVersion;
+  LocalizedNameMap        mNames;
+  LocalizedDescriptionMap mDescriptions;
+  LocalizedKeywordsMap    mKeywords;
+  QSet<Uuid>              mCategories;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace library
+}  // namespace librepcb
+
+#endif  // LIBREPCB_LIBRARY_LIBRARYELEMENTHEADER_H
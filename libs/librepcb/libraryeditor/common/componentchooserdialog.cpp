@@ -130,9 +130,11 @@ void ComponentChooserDialog::searchComponents(const QString& input) {
   setSelectedCategory(tl::nullopt);
 
   // min. 2 chars to avoid freeze on entering first character due to huge result
+  // and show only the most relevant results to keep the list responsive
   if (input.length() > 1) {
     QList<Uuid> components =
-        mWorkspace.getLibraryDb().getElementsBySearchKeyword<Component>(input);
+        mWorkspace.getLibraryDb().getElementsBySearchKeyword<Component>(
+            input, 200);
     foreach (const Uuid& uuid, components) {
       FilePath fp =
           mWorkspace.getLibraryDb().getLatestComponent(uuid);  // can throw
@@ -130,9 +130,11 @@ void PackageChooserDialog::searchPackages(const QString& input) {
   setSelectedCategory(tl::nullopt);
 
   // min. 2 chars to avoid freeze on entering first character due to huge result
+  // and show only the most relevant results to keep the list responsive
   if (input.length() > 1) {
     QList<Uuid> packages =
-        mWorkspace.getLibraryDb().getElementsBySearchKeyword<Package>(input);
+        mWorkspace.getLibraryDb().getElementsBySearchKeyword<Package>(
+            input, 200);
     foreach (const Uuid& uuid, packages) {
       FilePath fp =
           mWorkspace.getLibraryDb().getLatestPackage(uuid);  // can throw
@@ -147,9 +147,11 @@ void SymbolChooserDialog::searchSymbols(const QString& input) {
   setSelectedCategory(tl::nullopt);
 
   // min. 2 chars to avoid freeze on entering first character due to huge result
+  // and show only the most relevant results to keep the list responsive
   if (input.length() > 1) {
     QList<Uuid> symbols =
-        mWorkspace.getLibraryDb().getElementsBySearchKeyword<Symbol>(input);
+        mWorkspace.getLibraryDb().getElementsBySearchKeyword<Symbol>(
+            input, 200);
     foreach (const Uuid& uuid, symbols) {
       FilePath fp =
           mWorkspace.getLibraryDb().getLatestSymbol(uuid);  // can throw
@@ -28,8 +28,10 @@
 #include "../erc/ercmsg.h"
 #include "../project.h"
 #include "boardairwiresbuilder.h"
+#include "boardairwiresrebuilder.h"
 #include "boardfabricationoutputsettings.h"
 #include "boardlayerstack.h"
+#include "boardplanesrebuilder.h"
 #include "boardselectionquery.h"
 #include "boardusersettings.h"
 #include "items/bi_airwire.h"
@@ -79,6 +81,9 @@ Board::Board(const Board&                            other,
     mProject(other.getProject()),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mHasUnsavedChanges(true),
+    mPlanesRebuilder(new BoardPlanesRebuilder(*this)),
+    mAirWiresRebuilder(new BoardAirWiresRebuilder(*this)),
     mUuid(Uuid::createRandom()),
     mName(name),
     mDefaultFontFileName(other.mDefaultFontFileName) {
@@ -143,8 +148,12 @@ Board::Board(const Board&                            other,
       mHoles.append(copy);
     }
 
-    // rebuildAllPlanes(); --> fragments are copied too, so no need to rebuild
-    // them
+    // The fragments are copied too, so there's usually no need to rebuild
+    // them. But if the other board is still rebuilding them in the background,
+    // the copied fragments are outdated (or even empty).
+    if (other.mPlanesRebuilder->isBusy()) {
+      rebuildAllPlanes();
+    }
     updateErcMessages();
     updateIcon();
 
@@ -186,11 +195,14 @@ Board::Board(const Board&                            other,
 
 Board::Board(Project&                                project,
              std::unique_ptr<TransactionalDirectory> directory, bool create,
-             const QString& newName)
+             const QString& newName, const SExpression* parsedRoot)
   : QObject(&project),
     mProject(project),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mHasUnsavedChanges(create),
+    mPlanesRebuilder(new BoardPlanesRebuilder(*this)),
+    mAirWiresRebuilder(new BoardAirWiresRebuilder(*this)),
     mUuid(Uuid::createRandom()),
     mName("New Board") {
   try {
@@ -227,8 +239,14 @@ Board::Board(Project&                                project,
                       Path::rect(Point(0, 0), Point(100000000, 80000000)));
       mPolygons.append(new BI_Polygon(*this, polygon));
     } else {
-      SExpression root = SExpression::parse(
-          mDirectory->read(getFilePath().getFilename()), getFilePath());
+      // the file might already have been parsed by the caller
+      SExpression ownRoot;
+      if (!parsedRoot) {
+        ownRoot = SExpression::parse(
+            mDirectory->readView(getFilePath().getFilename()).getContent(),
+            getFilePath());
+      }
+      const SExpression& root = parsedRoot ? *parsedRoot : ownRoot;
 
       // the board seems to be ready to open, so we will create all needed
       // objects
@@ -324,7 +342,7 @@ Board::Board(Project&                                project,
       }
     }
 
-    rebuildAllPlanes();
+    rebuildAllPlanesAsync();  // don't block while opening the project
     updateErcMessages();
     updateIcon();
 
@@ -367,6 +385,9 @@ Board::Board(Project&                                project,
 Board::~Board() noexcept {
   Q_ASSERT(!mIsAddedToProject);
 
+  mPlanesRebuilder.reset();    // cancel a running rebuild
+  mAirWiresRebuilder.reset();  // cancel running rebuilds
+
   qDeleteAll(mErcMsgListUnplacedComponentInstances);
   mErcMsgListUnplacedComponentInstances.clear();
 
@@ -413,22 +434,82 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
   QList<BI_Base*>
       list;  // Note: The order of adding the items is very important (the
              // top most item must appear as the first item in the list)!
+  // only the candidates found by the spatial index need to be checked in
+  // detail, the list is then built in a fixed priority order by type (vias,
+  // netpoints and netlines in the order of their net segments, footprints, ...)
+  QSet<const BI_Base*>   hits;
+  QSet<BI_NetSegment*>   segments;
+  QMap<Uuid, BI_Device*> devices;  // same order as mDeviceInstances
+  foreach (BI_Base* item, getIndexedItemsAt(scenePosPx)) {
+    if ((!item->isSelectable()) ||
+        (!item->getGrabAreaScenePx().contains(scenePosPx))) {
+      continue;
+    }
+    hits.insert(item);
+    BI_Footprint* footprint = nullptr;
+    switch (item->getType()) {
+      case BI_Base::Type_t::Via:
+        segments.insert(&static_cast<BI_Via*>(item)->getNetSegment());
+        break;
+      case BI_Base::Type_t::NetPoint:
+        segments.insert(&static_cast<BI_NetPoint*>(item)->getNetSegment());
+        break;
+      case BI_Base::Type_t::NetLine:
+        segments.insert(&static_cast<BI_NetLine*>(item)->getNetSegment());
+        break;
+      case BI_Base::Type_t::Footprint:
+        footprint = static_cast<BI_Footprint*>(item);
+        break;
+      case BI_Base::Type_t::FootprintPad:
+        footprint = &static_cast<BI_FootprintPad*>(item)->getFootprint();
+        break;
+      case BI_Base::Type_t::StrokeText:
+        footprint = static_cast<BI_StrokeText*>(item)->getFootprint();
+        break;
+      default:
+        break;
+    }
+    if (footprint) {
+      BI_Device& device = footprint->getDeviceInstance();
+      devices.insert(device.getComponentInstanceUuid(), &device);
+    }
+  }
+  QList<BI_NetSegment*> hitSegments;  // same order as mNetSegments
+  if (!segments.isEmpty()) {
+    foreach (BI_NetSegment* segment, mNetSegments) {
+      if (segments.contains(segment)) {
+        hitSegments.append(segment);
+      }
+    }
+  }
   // vias
-  foreach (BI_Via* via, getViasAtScenePos(pos, nullptr)) { list.append(via); }
+  foreach (BI_NetSegment* segment, hitSegments) {
+    foreach (BI_Via* via, segment->getVias()) {
+      if (hits.contains(via)) {
+        list.append(via);
+      }
+    }
+  }
   // netpoints
-  foreach (BI_NetPoint* netpoint,
-           getNetPointsAtScenePos(pos, nullptr, nullptr)) {
-    list.append(netpoint);
+  foreach (BI_NetSegment* segment, hitSegments) {
+    foreach (BI_NetPoint* netpoint, segment->getNetPoints()) {
+      if (hits.contains(netpoint)) {
+        list.append(netpoint);
+      }
+    }
   }
   // netlines
-  foreach (BI_NetLine* netline, getNetLinesAtScenePos(pos, nullptr, nullptr)) {
-    list.append(netline);
+  foreach (BI_NetSegment* segment, hitSegments) {
+    foreach (BI_NetLine* netline, segment->getNetLines()) {
+      if (hits.contains(netline)) {
+        list.append(netline);
+      }
+    }
   }
   // footprints & pads
-  foreach (BI_Device* device, mDeviceInstances) {
+  foreach (BI_Device* device, devices) {
     BI_Footprint& footprint = device->getFootprint();
-    if (footprint.isSelectable() &&
-        footprint.getGrabAreaScenePx().contains(scenePosPx)) {
+    if (hits.contains(&footprint)) {
       if (footprint.getIsMirrored()) {
         list.append(&footprint);
       } else {
@@ -436,8 +517,7 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
       }
     }
     foreach (BI_FootprintPad* pad, footprint.getPads()) {
-      if (pad->isSelectable() &&
-          pad->getGrabAreaScenePx().contains(scenePosPx)) {
+      if (hits.contains(pad)) {
         if (pad->getIsMirrored()) {
           list.append(pad);
         } else {
@@ -445,9 +525,8 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
         }
       }
     }
-    foreach (BI_StrokeText* text, device->getFootprint().getStrokeTexts()) {
-      if (text->isSelectable() &&
-          text->getGrabAreaScenePx().contains(scenePosPx)) {
+    foreach (BI_StrokeText* text, footprint.getStrokeTexts()) {
+      if (hits.contains(text)) {
         if (GraphicsLayer::isTopLayer(*text->getText().getLayerName())) {
           list.prepend(text);
         } else {
@@ -457,30 +536,26 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
     }
   }
   // planes
-  foreach (BI_Plane* planes, mPlanes) {
-    if (planes->isSelectable() &&
-        planes->getGrabAreaScenePx().contains(scenePosPx)) {
-      list.append(planes);
+  foreach (BI_Plane* plane, mPlanes) {
+    if (hits.contains(plane)) {
+      list.append(plane);
     }
   }
   // polygons
   foreach (BI_Polygon* polygon, mPolygons) {
-    if (polygon->isSelectable() &&
-        polygon->getGrabAreaScenePx().contains(scenePosPx)) {
+    if (hits.contains(polygon)) {
       list.append(polygon);
     }
   }
   // texts
   foreach (BI_StrokeText* text, mStrokeTexts) {
-    if (text->isSelectable() &&
-        text->getGrabAreaScenePx().contains(scenePosPx)) {
+    if (hits.contains(text)) {
       list.append(text);
     }
   }
   // holes
   foreach (BI_Hole* hole, mHoles) {
-    if (hole->isSelectable() &&
-        hole->getGrabAreaScenePx().contains(scenePosPx)) {
+    if (hits.contains(hole)) {
       list.append(hole);
     }
   }
@@ -490,10 +565,16 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
 QList<BI_Via*> Board::getViasAtScenePos(const Point&     pos,
                                         const NetSignal* netsignal) const
     noexcept {
+  QPointF        scenePosPx = pos.toPxQPointF();
   QList<BI_Via*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getViasAtScenePos(pos, list);
+  foreach (BI_Base* item, getIndexedItemsAt(scenePosPx)) {
+    if (item->getType() != BI_Base::Type_t::Via) continue;
+    BI_Via* via = static_cast<BI_Via*>(item);
+    if (via->isSelectable() &&
+        via->getGrabAreaScenePx().contains(scenePosPx) &&
+        ((!netsignal) ||
+         (&via->getNetSegment().getNetSignal() == netsignal))) {
+      list.append(via);
     }
   }
   return list;
@@ -502,10 +583,17 @@ QList<BI_Via*> Board::getViasAtScenePos(const Point&     pos,
 QList<BI_NetPoint*> Board::getNetPointsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QPointF             scenePosPx = pos.toPxQPointF();
   QList<BI_NetPoint*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetPointsAtScenePos(pos, layer, list);
+  foreach (BI_Base* item, getIndexedItemsAt(scenePosPx)) {
+    if (item->getType() != BI_Base::Type_t::NetPoint) continue;
+    BI_NetPoint* netpoint = static_cast<BI_NetPoint*>(item);
+    if (netpoint->isSelectable() &&
+        netpoint->getGrabAreaScenePx().contains(scenePosPx) &&
+        ((!layer) || (netpoint->getLayerOfLines() == layer)) &&
+        ((!netsignal) ||
+         (&netpoint->getNetSegment().getNetSignal() == netsignal))) {
+      list.append(netpoint);
     }
   }
   return list;
@@ -514,10 +602,17 @@ QList<BI_NetPoint*> Board::getNetPointsAtScenePos(
 QList<BI_NetLine*> Board::getNetLinesAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QPointF            scenePosPx = pos.toPxQPointF();
   QList<BI_NetLine*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetLinesAtScenePos(pos, layer, list);
+  foreach (BI_Base* item, getIndexedItemsAt(scenePosPx)) {
+    if (item->getType() != BI_Base::Type_t::NetLine) continue;
+    BI_NetLine* netline = static_cast<BI_NetLine*>(item);
+    if (netline->isSelectable() &&
+        netline->getGrabAreaScenePx().contains(scenePosPx) &&
+        ((!layer) || (&netline->getLayer() == layer)) &&
+        ((!netsignal) ||
+         (&netline->getNetSegment().getNetSignal() == netsignal))) {
+      list.append(netline);
     }
   }
   return list;
@@ -526,15 +621,16 @@ QList<BI_NetLine*> Board::getNetLinesAtScenePos(
 QList<BI_FootprintPad*> Board::getPadsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QPointF                 scenePosPx = pos.toPxQPointF();
   QList<BI_FootprintPad*> list;
-  foreach (BI_Device* device, mDeviceInstances) {
-    foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
-      if (pad->isSelectable() &&
-          pad->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
-          ((!layer) || (pad->isOnLayer(layer->getName()))) &&
-          ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal))) {
-        list.append(pad);
-      }
+  foreach (BI_Base* item, getIndexedItemsAt(scenePosPx)) {
+    if (item->getType() != BI_Base::Type_t::FootprintPad) continue;
+    BI_FootprintPad* pad = static_cast<BI_FootprintPad*>(item);
+    if (pad->isSelectable() &&
+        pad->getGrabAreaScenePx().contains(scenePosPx) &&
+        ((!layer) || (pad->isOnLayer(layer->getName()))) &&
+        ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal))) {
+      list.append(pad);
     }
   }
   return list;
@@ -564,7 +660,8 @@ QList<BI_Base*> Board::getAllItems() const noexcept {
  ******************************************************************************/
 
 void Board::setGridProperties(const GridProperties& grid) noexcept {
-  *mGridProperties = grid;
+  *mGridProperties   = grid;
+  mHasUnsavedChanges = true;
 }
 
 /*******************************************************************************
@@ -591,6 +688,7 @@ void Board::addDeviceInstance(BI_Device& instance) {
   // add to board
   instance.addToBoard();  // can throw
   mDeviceInstances.insert(instance.getComponentInstanceUuid(), &instance);
+  mHasUnsavedChanges = true;
   updateErcMessages();
   emit deviceAdded(instance);
 }
@@ -603,6 +701,7 @@ void Board::removeDeviceInstance(BI_Device& instance) {
   // remove from board
   instance.removeFromBoard();  // can throw
   mDeviceInstances.remove(instance.getComponentInstanceUuid());
+  mHasUnsavedChanges = true;
   updateErcMessages();
   emit deviceRemoved(instance);
 }
@@ -633,6 +732,7 @@ void Board::addNetSegment(BI_NetSegment& netsegment) {
   // add to board
   netsegment.addToBoard();  // can throw
   mNetSegments.append(&netsegment);
+  mHasUnsavedChanges = true;
 }
 
 void Board::removeNetSegment(BI_NetSegment& netsegment) {
@@ -642,6 +742,7 @@ void Board::removeNetSegment(BI_NetSegment& netsegment) {
   // remove from board
   netsegment.removeFromBoard();  // can throw
   mNetSegments.removeOne(&netsegment);
+  mHasUnsavedChanges = true;
 }
 
 /*******************************************************************************
@@ -655,6 +756,7 @@ void Board::addPlane(BI_Plane& plane) {
   }
   plane.addToBoard();  // can throw
   mPlanes.append(&plane);
+  mHasUnsavedChanges = true;
 }
 
 void Board::removePlane(BI_Plane& plane) {
@@ -663,15 +765,19 @@ void Board::removePlane(BI_Plane& plane) {
   }
   plane.removeFromBoard();  // can throw
   mPlanes.removeOne(&plane);
+  mHasUnsavedChanges = true;
 }
 
 void Board::rebuildAllPlanes() noexcept {
-  QList<BI_Plane*> planes = mPlanes;
-  std::sort(planes.begin(), planes.end(),
-            [](const BI_Plane* p1, const BI_Plane* p2) {
-              return !(*p1 < *p2);
-            });  // sort by priority (highest priority first)
-  foreach (BI_Plane* plane, planes) { plane->rebuild(); }
+  mPlanesRebuilder->rebuild();
+}
+
+void Board::rebuildAllPlanesAsync() noexcept {
+  mPlanesRebuilder->startRebuild();
+}
+
+void Board::waitForPlanesRebuilt() noexcept {
+  mPlanesRebuilder->finish();
 }
 
 /*******************************************************************************
@@ -685,6 +791,7 @@ void Board::addPolygon(BI_Polygon& polygon) {
   }
   polygon.addToBoard();  // can throw
   mPolygons.append(&polygon);
+  markGeometryModified();
 }
 
 void Board::removePolygon(BI_Polygon& polygon) {
@@ -693,6 +800,7 @@ void Board::removePolygon(BI_Polygon& polygon) {
   }
   polygon.removeFromBoard();  // can throw
   mPolygons.removeOne(&polygon);
+  markGeometryModified();
 }
 
 /*******************************************************************************
@@ -706,6 +814,7 @@ void Board::addStrokeText(BI_StrokeText& text) {
   }
   text.addToBoard();  // can throw
   mStrokeTexts.append(&text);
+  mHasUnsavedChanges = true;
 }
 
 void Board::removeStrokeText(BI_StrokeText& text) {
@@ -714,6 +823,7 @@ void Board::removeStrokeText(BI_StrokeText& text) {
   }
   text.removeFromBoard();  // can throw
   mStrokeTexts.removeOne(&text);
+  mHasUnsavedChanges = true;
 }
 
 /*******************************************************************************
@@ -727,6 +837,7 @@ void Board::addHole(BI_Hole& hole) {
   }
   hole.addToBoard();  // can throw
   mHoles.append(&hole);
+  markGeometryModified();
 }
 
 void Board::removeHole(BI_Hole& hole) {
@@ -735,6 +846,7 @@ void Board::removeHole(BI_Hole& hole) {
   }
   hole.removeFromBoard();  // can throw
   mHoles.removeOne(&hole);
+  markGeometryModified();
 }
 
 /*******************************************************************************
@@ -746,27 +858,18 @@ void Board::triggerAirWiresRebuild() noexcept {
     return;
   }
 
+  // results of running asynchronous rebuilds would be outdated
+  mAirWiresRebuilder->cancel(mScheduledNetSignalsForAirWireRebuild);
+
   try {
     foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
-      // remove old airwires
-      while (BI_AirWire* airWire = mAirWires.take(netsignal)) {
-        airWire->removeFromBoard();  // can throw
-        delete airWire;
-      }
-
+      QVector<QPair<Point, Point>> airwires;
       if (netsignal && netsignal->isAddedToCircuit()) {
         // calculate new airwires
-        BoardAirWiresBuilder         builder(*this, *netsignal);
-        QVector<QPair<Point, Point>> airwires = builder.buildAirWires();
-
-        // add new airwires
-        foreach (const auto& points, airwires) {
-          QScopedPointer<BI_AirWire> airWire(
-              new BI_AirWire(*this, *netsignal, points.first, points.second));
-          airWire->addToBoard();  // can throw
-          mAirWires.insertMulti(netsignal, airWire.take());
-        }
+        BoardAirWiresBuilder builder(*this, *netsignal);
+        airwires = builder.buildAirWires();
       }
+      setAirWires(netsignal, airwires);  // can throw
     }
     mScheduledNetSignalsForAirWireRebuild.clear();
   } catch (const std::exception&
@@ -775,6 +878,15 @@ void Board::triggerAirWiresRebuild() noexcept {
   }
 }
 
+void Board::triggerAirWiresRebuildAsync() noexcept {
+  if (!mIsAddedToProject) {
+    return;
+  }
+
+  mAirWiresRebuilder->startRebuild(mScheduledNetSignalsForAirWireRebuild);
+  mScheduledNetSignalsForAirWireRebuild.clear();
+}
+
 void Board::forceAirWiresRebuild() noexcept {
   mScheduledNetSignalsForAirWireRebuild.unite(
       Toolbox::toSet(mProject.getCircuit().getNetSignals().values()));
@@ -782,6 +894,88 @@ void Board::forceAirWiresRebuild() noexcept {
   triggerAirWiresRebuild();
 }
 
+void Board::setAirWires(NetSignal*                          netsignal,
+                        const QVector<QPair<Point, Point>>& airwires) {
+  if (!mIsAddedToProject) {
+    return;
+  }
+
+  // only replace airwires which have actually changed, to avoid updating the
+  // graphics scene when moving items which don't affect the airwires
+  QSet<QPair<Point, Point>> newAirWires = Toolbox::toSet(airwires.toList());
+  foreach (BI_AirWire* airWire, mAirWires.values(netsignal)) {
+    QPair<Point, Point> points(airWire->getP1(), airWire->getP2());
+    if (!newAirWires.remove(points)) {
+      mAirWires.remove(netsignal, airWire);
+      airWire->removeFromBoard();  // can throw
+      delete airWire;
+    }
+  }
+  foreach (const auto& points, airwires) {
+    if (newAirWires.contains(points)) {
+      Q_ASSERT(netsignal);
+      QScopedPointer<BI_AirWire> airWire(
+          new BI_AirWire(*this, *netsignal, points.first, points.second));
+      airWire->addToBoard();  // can throw
+      mAirWires.insertMulti(netsignal, airWire.take());
+      newAirWires.remove(points);  // ignore duplicates
+    }
+  }
+}
+
+/*******************************************************************************
+ *  Graphics Item Index
+ ******************************************************************************/
+
+void Board::registerGraphicsItem(const QGraphicsItem& graphicsItem,
+                                 BI_Base&             item) noexcept {
+  Q_ASSERT(!mItemsByGraphicsItem.contains(&graphicsItem));
+  mItemsByGraphicsItem.insert(&graphicsItem, &item);
+}
+
+void Board::unregisterGraphicsItem(const QGraphicsItem& graphicsItem) noexcept {
+  Q_ASSERT(mItemsByGraphicsItem.contains(&graphicsItem));
+  mItemsByGraphicsItem.remove(&graphicsItem);
+}
+
+/*******************************************************************************
+ *  Modification Tracking
+ ******************************************************************************/
+
+void Board::markDeviceModified(const BI_Device& device) noexcept {
+  mHasUnsavedChanges = true;
+  mModifications.devices.insert(&device);
+  // Resolve the nets of the pads now since the device might be deleted before
+  // the modifications are taken.
+  foreach (const BI_FootprintPad* pad, device.getFootprint().getPads()) {
+    mModifications.netSignals.insert(pad->getCompSigInstNetSignal());
+  }
+  mPlanesRebuilder->restartIfBusy();
+}
+
+void Board::markNetSignalModified(const NetSignal* netsignal) noexcept {
+  mHasUnsavedChanges = true;
+  mModifications.netSignals.insert(netsignal);
+  mPlanesRebuilder->restartIfBusy();
+}
+
+void Board::markAllModified() noexcept {
+  mHasUnsavedChanges = true;
+  mModifications.all = true;
+  mPlanesRebuilder->restartIfBusy();
+}
+
+void Board::markGeometryModified() noexcept {
+  mHasUnsavedChanges = true;
+  mPlanesRebuilder->restartIfBusy();
+}
+
+Board::Modifications Board::takeModifications() noexcept {
+  Modifications modifications = mModifications;
+  mModifications              = Modifications();
+  return modifications;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -815,16 +1009,23 @@ void Board::removeFromProject() {
     sgl.add([item]() { item->addToBoard(); });
   }
   mIsAddedToProject = false;
+  // The files will be removed on the next save, so they need to be written
+  // again if the board gets added to the project again (e.g. by undo).
+  mHasUnsavedChanges = true;
+  mAirWiresRebuilder->cancelAll();
   updateErcMessages();
   sgl.dismiss();
 }
 
 void Board::save() {
   if (mIsAddedToProject) {
-    // save board file
-    SExpression brdDoc(serializeToDomElement("librepcb_board"));  // can throw
-    mDirectory->write(getFilePath().getFilename(),
-                      brdDoc.toByteArray());  // can throw
+    // save board file, but only if it was modified since the last save
+    if (mHasUnsavedChanges) {
+      SExpression brdDoc(serializeToDomElement("librepcb_board"));  // can throw
+      mDirectory->write(getFilePath().getFilename(),
+                        brdDoc.toByteArray());  // can throw
+      mHasUnsavedChanges = false;
+    }
 
     // save user settings
     SExpression usrDoc(mUserSettings->serializeToDomElement(
@@ -873,44 +1074,48 @@ void Board::setSelectionRect(const Point& p1, const Point& p2,
   mGraphicsScene->setSelectionRect(p1, p2);
   if (updateItems) {
     QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+    // only the candidates found by the spatial index need to be checked in
+    // detail, all other items are deselected
+    QSet<BI_Base*> selected;
+    foreach (BI_Base* item, getIndexedItemsIn(rectPx)) {
+      if (item->isSelectable() &&
+          item->getGrabAreaScenePx().intersects(rectPx)) {
+        selected.insert(item);
+      }
+    }
     foreach (BI_Device* component, mDeviceInstances) {
       BI_Footprint& footprint       = component->getFootprint();
-      bool          selectFootprint = footprint.isSelectable() &&
-                             footprint.getGrabAreaScenePx().intersects(rectPx);
+      bool          selectFootprint = selected.contains(&footprint);
       footprint.setSelected(selectFootprint);
       foreach (BI_FootprintPad* pad, footprint.getPads()) {
-        bool selectPad =
-            pad->isSelectable() && pad->getGrabAreaScenePx().intersects(rectPx);
-        pad->setSelected(selectFootprint || selectPad);
+        pad->setSelected(selectFootprint || selected.contains(pad));
       }
       foreach (BI_StrokeText* text, footprint.getStrokeTexts()) {
-        bool selectText = text->isSelectable() &&
-                          text->getGrabAreaScenePx().intersects(rectPx);
-        text->setSelected(selectFootprint || selectText);
+        text->setSelected(selectFootprint || selected.contains(text));
       }
     }
     foreach (BI_NetSegment* segment, mNetSegments) {
-      segment->setSelectionRect(rectPx);
+      foreach (BI_Via* via, segment->getVias()) {
+        via->setSelected(selected.contains(via));
+      }
+      foreach (BI_NetPoint* netpoint, segment->getNetPoints()) {
+        netpoint->setSelected(selected.contains(netpoint));
+      }
+      foreach (BI_NetLine* netline, segment->getNetLines()) {
+        netline->setSelected(selected.contains(netline));
+      }
     }
     foreach (BI_Plane* plane, mPlanes) {
-      bool select = plane->isSelectable() &&
-                    plane->getGrabAreaScenePx().intersects(rectPx);
-      plane->setSelected(select);
+      plane->setSelected(selected.contains(plane));
     }
     foreach (BI_Polygon* polygon, mPolygons) {
-      bool select = polygon->isSelectable() &&
-                    polygon->getGrabAreaScenePx().intersects(rectPx);
-      polygon->setSelected(select);
+      polygon->setSelected(selected.contains(polygon));
     }
     foreach (BI_StrokeText* text, mStrokeTexts) {
-      bool select =
-          text->isSelectable() && text->getGrabAreaScenePx().intersects(rectPx);
-      text->setSelected(select);
+      text->setSelected(selected.contains(text));
     }
     foreach (BI_Hole* hole, mHoles) {
-      bool select =
-          hole->isSelectable() && hole->getGrabAreaScenePx().intersects(rectPx);
-      hole->setSelected(select);
+      hole->setSelected(selected.contains(hole));
     }
   }
 }
@@ -1016,6 +1221,38 @@ void Board::updateErcMessages() noexcept {
   }
 }
 
+QList<BI_Base*> Board::getIndexedItemsAt(const QPointF& posPx) const noexcept {
+  return getIndexedItems(mGraphicsScene->items(
+      posPx, Qt::IntersectsItemBoundingRect, Qt::DescendingOrder));
+}
+
+QList<BI_Base*> Board::getIndexedItemsIn(const QRectF& rectPx) const noexcept {
+  return getIndexedItems(mGraphicsScene->items(
+      rectPx, Qt::IntersectsItemBoundingRect, Qt::DescendingOrder));
+}
+
+QList<BI_Base*> Board::getIndexedItems(
+    const QList<QGraphicsItem*>& graphicsItems) const noexcept {
+  // The graphics scene already maintains a spatial index (BSP tree) of all
+  // graphics items which is kept up to date whenever an item is added,
+  // removed, moved or modified. Items might consist of several child graphics
+  // items, so the parents are looked up as well.
+  QList<BI_Base*> items;
+  QSet<BI_Base*>  found;
+  foreach (QGraphicsItem* graphicsItem, graphicsItems) {
+    for (const QGraphicsItem* i = graphicsItem; i; i = i->parentItem()) {
+      if (BI_Base* item = mItemsByGraphicsItem.value(i)) {
+        if (!found.contains(item)) {
+          found.insert(item);
+          items.append(item);
+        }
+        break;
+      }
+    }
+  }
+  return items;
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -1023,7 +1260,7 @@ void Board::updateErcMessages() noexcept {
 Board* Board::create(Project&                                project,
                      std::unique_ptr<TransactionalDirectory> directory,
                      const ElementName&                      name) {
-  return new Board(project, std::move(directory), true, *name);
+  return new Board(project, std::move(directory), true, *name, nullptr);
 }
 
 /*******************************************************************************
@@ -71,6 +71,8 @@ class BoardLayerStack;
 class BoardFabricationOutputSettings;
 class BoardUserSettings;
 class BoardSelectionQuery;
+class BoardAirWiresRebuilder;
+class BoardPlanesRebuilder;
 
 /*******************************************************************************
  *  Class Board
@@ -119,13 +121,33 @@ public:
     ZValue_AirWires,  ///< Z value for librepcb::project::BI_AirWire items
   };
 
+  /**
+   * @brief Items which were modified since the last call to
+   *        #takeModifications()
+   *
+   * Collected by the undo commands and used by the incremental
+   * ::librepcb::project::BoardDesignRuleCheck to determine which results need
+   * to be recalculated. The pointers are only used as keys, they might
+   * already be dangling!
+   */
+  struct Modifications {
+    bool                   all;  ///< Everything needs to be recalculated
+    QSet<const NetSignal*> netSignals;
+    QSet<const BI_Device*> devices;
+
+    Modifications() noexcept : all(false), netSignals(), devices() {}
+  };
+
   // Constructors / Destructor
   Board()                   = delete;
   Board(const Board& other) = delete;
   Board(const Board& other, std::unique_ptr<TransactionalDirectory> directory,
         const ElementName& name);
   Board(Project& project, std::unique_ptr<TransactionalDirectory> directory)
-    : Board(project, std::move(directory), false, QString()) {}
+    : Board(project, std::move(directory), false, QString(), nullptr) {}
+  Board(Project& project, std::unique_ptr<TransactionalDirectory> directory,
+        const SExpression& root)
+    : Board(project, std::move(directory), false, QString(), &root) {}
   ~Board() noexcept;
 
   // Getters: General
@@ -198,6 +220,8 @@ public:
   void                    addPlane(BI_Plane& plane);
   void                    removePlane(BI_Plane& plane);
   void                    rebuildAllPlanes() noexcept;
+  void                    rebuildAllPlanesAsync() noexcept;
+  void                    waitForPlanesRebuilt() noexcept;
 
   // Polygon Methods
   const QList<BI_Polygon*>& getPolygons() const noexcept { return mPolygons; }
@@ -222,7 +246,26 @@ public:
     mScheduledNetSignalsForAirWireRebuild.insert(netsignal);
   }
   void triggerAirWiresRebuild() noexcept;
+  void triggerAirWiresRebuildAsync() noexcept;
   void forceAirWiresRebuild() noexcept;
+  void setAirWires(NetSignal*                          netsignal,
+                   const QVector<QPair<Point, Point>>& airwires);
+
+  // Graphics Item Index
+  void registerGraphicsItem(const QGraphicsItem& graphicsItem,
+                            BI_Base&             item) noexcept;
+  void unregisterGraphicsItem(const QGraphicsItem& graphicsItem) noexcept;
+
+  // Modification Tracking
+  void          markNetSignalModified(const NetSignal* netsignal) noexcept;
+  void          markDeviceModified(const BI_Device& device) noexcept;
+  void          markAllModified() noexcept;
+  void          markGeometryModified() noexcept;
+  Modifications takeModifications() noexcept;
+
+  // Unsaved Changes Tracking (only modified boards are written by #save())
+  void markUnsaved() noexcept { mHasUnsavedChanges = true; }
+  bool hasUnsavedChanges() const noexcept { return mHasUnsavedChanges; }
 
   // General Methods
   void addToProject();
@@ -280,9 +323,13 @@ signals:
 
 private:
   Board(Project& project, std::unique_ptr<TransactionalDirectory> directory,
-        bool create, const QString& newName);
-  void updateIcon() noexcept;
-  void updateErcMessages() noexcept;
+        bool create, const QString& newName, const SExpression* parsedRoot);
+  void            updateIcon() noexcept;
+  void            updateErcMessages() noexcept;
+  QList<BI_Base*> getIndexedItemsAt(const QPointF& posPx) const noexcept;
+  QList<BI_Base*> getIndexedItemsIn(const QRectF& rectPx) const noexcept;
+  QList<BI_Base*> getIndexedItems(const QList<QGraphicsItem*>& graphicsItems)
+      const noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -291,6 +338,7 @@ private:
   Project& mProject;  ///< A reference to the Project object (from the ctor)
   std::unique_ptr<TransactionalDirectory> mDirectory;
   bool                                    mIsAddedToProject;
+  bool                                    mHasUnsavedChanges;
 
   QScopedPointer<GraphicsScene>                  mGraphicsScene;
   QScopedPointer<BoardLayerStack>                mLayerStack;
@@ -298,8 +346,11 @@ private:
   QScopedPointer<BoardDesignRules>               mDesignRules;
   QScopedPointer<BoardFabricationOutputSettings> mFabricationOutputSettings;
   QScopedPointer<BoardUserSettings>              mUserSettings;
+  QScopedPointer<BoardPlanesRebuilder>           mPlanesRebuilder;
+  QScopedPointer<BoardAirWiresRebuilder>         mAirWiresRebuilder;
   QRectF                                         mViewRect;
   QSet<NetSignal*> mScheduledNetSignalsForAirWireRebuild;
+  Modifications    mModifications;
 
   // Attributes
   Uuid        mUuid;
@@ -316,6 +367,10 @@ private:
   QList<BI_Hole*>                     mHoles;
   QMultiHash<NetSignal*, BI_AirWire*> mAirWires;
 
+  /// All graphics items of the items added to the board, used to find items
+  /// by position with the spatial index of #mGraphicsScene
+  QHash<const QGraphicsItem*, BI_Base*> mItemsByGraphicsItem;
+
   // ERC messages
   QHash<Uuid, ErcMsg*> mErcMsgListUnplacedComponentInstances;
 };
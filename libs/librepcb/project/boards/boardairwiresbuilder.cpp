@@ -27,6 +27,7 @@
 #include "../circuit/netsignal.h"
 #include "../project.h"
 #include "board.h"
+#include "boardplanefragmentsbuilder.h"
 #include "items/bi_footprintpad.h"
 #include "items/bi_netline.h"
 #include "items/bi_netpoint.h"
@@ -36,11 +37,13 @@
 
 #include <delaunay-triangulation/delaunay.h>
 #include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/clipperhelpers.h>
 #include <librepcb/library/pkg/footprintpad.h>
-#include <unordered_map>
 
 #include <QtCore>
 
+#include <numeric>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -51,29 +54,25 @@ namespace project {
 static QVector<QPair<Point, Point>> kruskalMst(
     std::vector<delaunay::Edge<qreal>>&    aEdges,
     std::vector<delaunay::Vector2<qreal>>& aNodes) noexcept {
-  unsigned int nodeNumber      = aNodes.size();
-  unsigned int mstExpectedSize = nodeNumber - 1;
-  unsigned int mstSize         = 0;
-  bool         ratsnestLines   = false;
+  int nodeNumber      = static_cast<int>(aNodes.size());
+  int mstExpectedSize = nodeNumber - 1;
+  int mstSize         = 0;
 
-  // printf("mst nodes : %d edges : %d\n", aNodes.size(), aEdges.size () );
   // The output
   QVector<QPair<Point, Point>> mst;
 
-  // Set tags for marking cycles
-  std::unordered_map<int, int> tags;
-  unsigned int                 tag = 0;
-
-  for (auto& node : aNodes) {
-    node.tag      = tag;
-    tags[node.id] = tag++;
-  }
-
-  // Lists of nodes connected together (subtrees) to detect cycles in the
-  // graph
-  std::vector<std::list<int>> cycles(nodeNumber);
-
-  for (unsigned int i = 0; i < nodeNumber; ++i) cycles[i].push_back(i);
+  // Union-find over the node IDs (which are 0..n-1) to detect cycles in the
+  // graph, with union by rank and path halving
+  std::vector<int> parents(nodeNumber);
+  std::vector<int> ranks(nodeNumber, 0);
+  std::iota(parents.begin(), parents.end(), 0);
+  auto find = [&parents](int node) {
+    while (parents[node] != node) {
+      parents[node] = parents[parents[node]];
+      node          = parents[node];
+    }
+    return node;
+  };
 
   // Kruskal algorithm requires edges to be sorted by their weight
   std::sort(aEdges.begin(), aEdges.end(),
@@ -81,66 +80,38 @@ static QVector<QPair<Point, Point>> kruskalMst(
               return a.weight > b.weight;
             });
 
-  while (mstSize < mstExpectedSize && !aEdges.empty()) {
-    auto& dt = aEdges.back();
-
-    int srcTag = tags[dt.p1.id];
-    int trgTag = tags[dt.p2.id];
-    // printf("mstSize %d %d %f %d<>%d\n", mstSize, mstExpectedSize,
-    // dt.weight, srcTag, trgTag);
+  // Edges are processed from the back, i.e. with increasing weight
+  for (auto it = aEdges.rbegin();
+       (it != aEdges.rend()) && (mstSize < mstExpectedSize); ++it) {
+    const delaunay::Edge<qreal>& dt      = *it;
+    int                          srcRoot = find(dt.p1.id);
+    int                          trgRoot = find(dt.p2.id);
 
     // Check if by adding this edge we are going to join two different
     // forests
-    if (srcTag != trgTag) {
+    if (srcRoot != trgRoot) {
       // Because edges are sorted by their weight, first we always process
-      // connected
-      // items (weight == 0). Once we stumble upon an edge with non-zero
-      // weight,
-      // it means that the rest of the lines are ratsnest.
-      if (!ratsnestLines && dt.weight >= 0) ratsnestLines = true;
-
-      // Update tags
-      if (ratsnestLines) {
-        for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-             ++it) {
-          tags[aNodes[*it].id] = srcTag;
-        }
-
-        // Do a copy of edge, but make it RN_EDGE_MST. In contrary to
-        // RN_EDGE,
-        // RN_EDGE_MST saves both source and target node and does not
-        // require any other
-        // edges to exist for getting source/target nodes
-        // CN_EDGE newEdge ( dt.GetSourceNode(), dt.GetTargetNode(),
-        // dt.GetWeight() );
-
-        // assert( newEdge.GetSourceNode()->GetTag() !=
-        // newEdge.GetTargetNode()->GetTag() );
-        // assert(dt.p1.tag != dt.p2.tag);
+      // connected items (weight < 0). Once we stumble upon an edge with
+      // non-negative weight, it means that the rest of the lines are
+      // ratsnest.
+      if (dt.weight >= 0) {
         mst.append(qMakePair(Point(dt.p1.x, dt.p1.y), Point(dt.p2.x, dt.p2.y)));
         ++mstSize;
       } else {
-        // for( it = cycles[trgTag].begin(), itEnd =
-        // cycles[trgTag].end(); it != itEnd; ++it )
-        // for( auto it : cycles[trgTag] )
-        for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-             ++it) {
-          tags[aNodes[*it].id] = srcTag;
-          aNodes[*it].tag      = srcTag;
-        }
-
         // Processing a connection, decrease the expected size of the
         // ratsnest MST
         --mstExpectedSize;
       }
 
-      // Move nodes that were marked with old tag to the list marked with
-      // the new tag
-      cycles[srcTag].splice(cycles[srcTag].end(), cycles[trgTag]);
+      // Merge the smaller tree into the larger one
+      if (ranks[srcRoot] < ranks[trgRoot]) {
+        std::swap(srcRoot, trgRoot);
+      }
+      parents[trgRoot] = srcRoot;
+      if (ranks[srcRoot] == ranks[trgRoot]) {
+        ++ranks[srcRoot];
+      }
     }
-
-    // Remove the edge that was just processed
-    aEdges.pop_back();
   }
 
   return mst;
@@ -150,96 +121,147 @@ static QVector<QPair<Point, Point>> kruskalMst(
  *  Constructors / Destructor
  ******************************************************************************/
 
-BoardAirWiresBuilder::BoardAirWiresBuilder(const Board&     board,
-                                           const NetSignal& netsignal) noexcept
-  : mBoard(board), mNetSignal(netsignal) {
-}
-
-BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
-}
-
-/*******************************************************************************
- *  General Methods
- ******************************************************************************/
-
-QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
-  std::vector<delaunay::Vector2<qreal>> points;
-  QHash<const BI_NetLineAnchor*, int>   anchorMap;
-  QHash<int, QString>                   layerMap;
-  std::vector<delaunay::Edge<qreal>>    edges;
+BoardAirWiresBuilder::BoardAirWiresBuilder(
+    const Board& board, const NetSignal& netsignal) noexcept {
+  QHash<const BI_NetLineAnchor*, int> anchorMap;
 
   // pads
-  foreach (ComponentSignalInstance* cmpSig, mNetSignal.getComponentSignals()) {
+  foreach (ComponentSignalInstance* cmpSig, netsignal.getComponentSignals()) {
     Q_ASSERT(cmpSig);
     foreach (BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
-      if (&pad->getBoard() != &mBoard) continue;
-      int   id  = points.size();
-      Point pos = pad->getPosition();
-      points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), id);
-      anchorMap[pad] = id;
+      if (&pad->getBoard() != &board) continue;
+      anchorMap[pad] = mAnchorPositions.count();
+      mAnchorPositions.append(pad->getPosition());
       if (pad->getLibPad().getBoardSide() ==
           library::FootprintPad::BoardSide::THT) {
-        layerMap[id] = QString();  // on all layers
+        mAnchorLayers.append(QString());  // on all layers
       } else {
-        layerMap[id] = pad->getLayerName();
+        mAnchorLayers.append(pad->getLayerName());
       }
     }
   }
 
   // vias, netpoints, netlines
-  foreach (const BI_NetSegment* netsegment, mNetSignal.getBoardNetSegments()) {
+  foreach (const BI_NetSegment* netsegment, netsignal.getBoardNetSegments()) {
     Q_ASSERT(netsegment);
-    if (&netsegment->getBoard() != &mBoard) continue;
+    if (&netsegment->getBoard() != &board) continue;
     foreach (const BI_Via* via, netsegment->getVias()) {
       Q_ASSERT(via);
-      int   id  = points.size();
-      Point pos = via->getPosition();
-      points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), id);
-      anchorMap[via] = id;
-      layerMap[id]   = QString();  // on all layers
+      anchorMap[via] = mAnchorPositions.count();
+      mAnchorPositions.append(via->getPosition());
+      mAnchorLayers.append(QString());  // on all layers
     }
     foreach (const BI_NetPoint* netpoint, netsegment->getNetPoints()) {
       Q_ASSERT(netpoint);
       if (const GraphicsLayer* layer = netpoint->getLayerOfLines()) {
-        int   id  = points.size();
-        Point pos = netpoint->getPosition();
-        points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), id);
-        anchorMap[netpoint] = id;
-        layerMap[id]        = layer->getName();
+        anchorMap[netpoint] = mAnchorPositions.count();
+        mAnchorPositions.append(netpoint->getPosition());
+        mAnchorLayers.append(layer->getName());
       }
     }
     foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
       Q_ASSERT(netline);
       Q_ASSERT(anchorMap.contains(&netline->getStartPoint()));
       Q_ASSERT(anchorMap.contains(&netline->getEndPoint()));
-      edges.emplace_back(points[anchorMap[&netline->getStartPoint()]],
-                         points[anchorMap[&netline->getEndPoint()]], -1);
+      mNetLines.append(qMakePair(anchorMap[&netline->getStartPoint()],
+                                 anchorMap[&netline->getEndPoint()]));
     }
   }
 
-  // determine connections made by planes
-  foreach (const BI_Plane* plane, mNetSignal.getBoardPlanes()) {
+  // planes
+  foreach (const BI_Plane* plane, netsignal.getBoardPlanes()) {
     Q_ASSERT(plane);
-    if (&plane->getBoard() != &mBoard) continue;
-    foreach (const Path& fragment, plane->getFragments()) {
-      int lastId = -1;
-      for (const auto& point : points) {
-        QString pointLayer = layerMap[point.id];
-        if (pointLayer.isNull() || (pointLayer == plane->getLayerName())) {
-          Point p(point.x, point.y);
-          if (fragment.toQPainterPathPx().contains(p.toPxQPointF())) {
-            if (lastId >= 0) {
-              edges.emplace_back(points[lastId], points[point.id], -1);
-            }
-            lastId = point.id;
+    if (&plane->getBoard() != &board) continue;
+    mPlanes.append(qMakePair(*plane->getLayerName(), plane->getFragments()));
+  }
+}
+
+BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
+  // connections made by netlines
+  QVector<QPair<int, int>> connections = mNetLines;
+
+  // determine connections made by planes
+  // To quickly find the anchors within the bounding rect of a plane fragment,
+  // the anchors are sorted by their x coordinate.
+  QVector<int> idsSortedByX(mAnchorPositions.count());
+  std::iota(idsSortedByX.begin(), idsSortedByX.end(), 0);
+  std::sort(idsSortedByX.begin(), idsSortedByX.end(), [this](int a, int b) {
+    return mAnchorPositions[a].getX() < mAnchorPositions[b].getX();
+  });
+  foreach (const auto& plane, mPlanes) {
+    foreach (const Path& fragment, plane.second) {
+      // fragments don't contain arcs, so the conversion is lossless
+      ClipperLib::Path path = ClipperHelpers::convert(
+          fragment, BoardPlaneFragmentsBuilder::maxArcTolerance());
+      ClipperLib::IntRect rect =
+          ClipperHelpers::getBoundingRect(ClipperLib::Paths{path});
+      auto it = std::lower_bound(
+          idsSortedByX.begin(), idsSortedByX.end(), rect.left,
+          [this](int id, ClipperLib::cInt x) {
+            return mAnchorPositions[id].getX().toNm() < x;
+          });
+      QVector<int> ids;
+      for (; (it != idsSortedByX.end()) &&
+             (mAnchorPositions[*it].getX().toNm() <= rect.right);
+           ++it) {
+        const Point& pos = mAnchorPositions[*it];
+        if ((pos.getY().toNm() < rect.top) ||
+            (pos.getY().toNm() > rect.bottom)) {
+          continue;
+        }
+        const QString& anchorLayer = mAnchorLayers.at(*it);
+        if (anchorLayer.isNull() || (anchorLayer == plane.first)) {
+          ClipperLib::IntPoint p(pos.getX().toNm(), pos.getY().toNm());
+          if (ClipperLib::PointInPolygon(p, path) != 0) {  // incl. boundary
+            ids.append(*it);
           }
         }
       }
+      // connect the anchors in the same order as they were added
+      std::sort(ids.begin(), ids.end());
+      for (int i = 1; i < ids.count(); ++i) {
+        connections.append(qMakePair(ids[i - 1], ids[i]));
+      }
     }
   }
 
+  // find airwires
+  return buildMinimumSpanningTree(mAnchorPositions, connections);
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildMinimumSpanningTree(
+    const QVector<Point>&           anchors,
+    const QVector<QPair<int, int>>& connections) noexcept {
+  std::vector<delaunay::Vector2<qreal>> points;
+  std::vector<delaunay::Edge<qreal>>    edges;
+
+  // anchors (the ID is the index)
+  points.reserve(anchors.count());
+  for (int id = 0; id < anchors.count(); ++id) {
+    const Point& pos = anchors.at(id);
+    points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), id);
+  }
+
+  // already connected anchors
+  edges.reserve(connections.count() + 3 * points.size());  // incl. triangles
+  foreach (const auto& connection, connections) {
+    edges.emplace_back(points[connection.first], points[connection.second],
+                       -1);
+  }
+
   // remember how many edges are already known as connected
-  uint connectedEdges = edges.size();
+  std::size_t connectedEdges = edges.size();
 
   // determine additional edges between found points (candidates for airwires)
   if (points.size() >= 3) {  // minimum 3 points needed for triangulation
@@ -251,7 +273,7 @@ QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
   }
 
   // determine weights of these new edges
-  for (uint i = connectedEdges; i < edges.size(); ++i) {
+  for (std::size_t i = connectedEdges; i < edges.size(); ++i) {
     edges[i].weight = edges[i].p1.dist2(edges[i].p2);
   }
 
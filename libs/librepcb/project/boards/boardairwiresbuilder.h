@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include <librepcb/common/geometry/path.h>
 #include <librepcb/common/units/point.h>
 
 #include <QtCore>
@@ -42,6 +43,10 @@ class Board;
 
 /**
  * @brief The BoardAirWiresBuilder class
+ *
+ * All data required from the board is copied in the constructor, so the
+ * constructor must be called in the thread the board lives in, but
+ * #buildAirWires() can then be called in any thread.
  */
 class BoardAirWiresBuilder final {
 public:
@@ -54,12 +59,31 @@ public:
   // General Methods
   QVector<QPair<Point, Point>> buildAirWires() const;
 
+  // Static Methods
+
+  /**
+   * @brief Determine the airwires between anchors
+   *
+   * Calculates the minimum spanning tree of the Delaunay triangulation of the
+   * anchors, where already connected anchors don't need any airwire.
+   *
+   * @param anchors       Positions of all anchors
+   * @param connections   Pairs of indices of connected anchors
+   *
+   * @return The airwires (start and end position)
+   */
+  static QVector<QPair<Point, Point>> buildMinimumSpanningTree(
+      const QVector<Point>&           anchors,
+      const QVector<QPair<int, int>>& connections) noexcept;
+
   // Operator Overloadings
   BoardAirWiresBuilder& operator=(const BoardAirWiresBuilder& rhs) = delete;
 
-private:  // Data
-  const Board&     mBoard;
-  const NetSignal& mNetSignal;
+private:  // Data (copied from the board)
+  QVector<Point>                         mAnchorPositions;
+  QVector<QString>                       mAnchorLayers;  ///< Null = all layers
+  QVector<QPair<int, int>>               mNetLines;      ///< Anchor indices
+  QVector<QPair<QString, QVector<Path>>> mPlanes;        ///< Layer, fragments
 };
 
 /*******************************************************************************
@@ -0,0 +1,167 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardairwiresrebuilder.h"
+
+#include "../circuit/netsignal.h"
+#include "board.h"
+#include "boardairwiresbuilder.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardAirWiresRebuilder::BoardAirWiresRebuilder(Board& board) noexcept
+  : QObject(nullptr),
+    mBoard(board),
+    mScheduledNetSignals(),
+    mScheduleTimer(),
+    mRunningJobs() {
+  mScheduleTimer.setSingleShot(true);
+  mScheduleTimer.setInterval(0);
+  connect(&mScheduleTimer, &QTimer::timeout, this,
+          &BoardAirWiresRebuilder::startScheduledJobs);
+}
+
+BoardAirWiresRebuilder::~BoardAirWiresRebuilder() noexcept {
+  // Jobs don't access the board, so there's no need to wait for them
+  cancelAll();
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+bool BoardAirWiresRebuilder::isBusy() const noexcept {
+  return (!mScheduledNetSignals.isEmpty()) || (!mRunningJobs.isEmpty());
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardAirWiresRebuilder::startRebuild(
+    const QSet<NetSignal*>& netsignals) noexcept {
+  mScheduledNetSignals.unite(netsignals);
+  if (!mScheduledNetSignals.isEmpty()) {
+    mScheduleTimer.start();
+  }
+}
+
+void BoardAirWiresRebuilder::cancel(
+    const QSet<NetSignal*>& netsignals) noexcept {
+  mScheduledNetSignals.subtract(netsignals);
+  foreach (NetSignal* netsignal, netsignals) {
+    if (QFutureWatcher<AirWires>* watcher = mRunningJobs.take(netsignal)) {
+      watcher->disconnect(this);
+      watcher->deleteLater();
+    }
+  }
+}
+
+void BoardAirWiresRebuilder::cancelAll() noexcept {
+  mScheduleTimer.stop();
+  mScheduledNetSignals.clear();
+  foreach (QFutureWatcher<AirWires>* watcher, mRunningJobs) {
+    watcher->disconnect(this);
+    watcher->deleteLater();
+  }
+  mRunningJobs.clear();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardAirWiresRebuilder::startScheduledJobs() noexcept {
+  foreach (NetSignal* netsignal, mScheduledNetSignals) {
+    if (mRunningJobs.contains(netsignal)) {
+      continue;  // will be started when the running job has finished
+    }
+    mScheduledNetSignals.remove(netsignal);
+
+    if ((!netsignal) || (!netsignal->isAddedToCircuit())) {
+      // nothing to build, just remove the airwires
+      try {
+        mBoard.setAirWires(netsignal, AirWires());  // can throw
+      } catch (const Exception& e) {
+        qCritical() << "Failed to remove airwires:" << e.getMsg();
+      }
+      continue;
+    }
+
+    // the builder copies all the data it needs from the board
+    auto builder = std::make_shared<BoardAirWiresBuilder>(mBoard, *netsignal);
+    QPointer<NetSignal>       guard(netsignal);
+    QFutureWatcher<AirWires>* watcher = new QFutureWatcher<AirWires>(this);
+    connect(watcher, &QFutureWatcher<AirWires>::finished, this,
+            [this, netsignal, guard]() { jobFinished(netsignal, guard); });
+    mRunningJobs.insert(netsignal, watcher);
+    watcher->setFuture(
+        QtConcurrent::run([builder]() { return builder->buildAirWires(); }));
+  }
+}
+
+void BoardAirWiresRebuilder::jobFinished(
+    NetSignal* netsignal, const QPointer<NetSignal>& guard) noexcept {
+  QFutureWatcher<AirWires>* watcher = mRunningJobs.take(netsignal);
+  Q_ASSERT(watcher);
+  watcher->deleteLater();
+
+  // The result is applied even if the net signal has been scheduled again in
+  // the meantime since it's still more recent than the current airwires.
+  // However, if it has been removed from the circuit (or even deleted)
+  // meanwhile, it must not get any airwires anymore.
+  AirWires airwires;
+  if (guard && guard->isAddedToCircuit()) {
+    airwires = watcher->result();
+  }
+  try {
+    mBoard.setAirWires(netsignal, airwires);  // can throw
+  } catch (const Exception& e) {
+    qCritical() << "Failed to update airwires:" << e.getMsg();
+  }
+
+  if (mScheduledNetSignals.contains(netsignal)) {
+    mScheduleTimer.start();
+  } else if (!isBusy()) {
+    emit finished();
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,122 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDAIRWIRESREBUILDER_H
+#define LIBREPCB_PROJECT_BOARDAIRWIRESREBUILDER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/units/point.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetSignal;
+
+/*******************************************************************************
+ *  Class BoardAirWiresRebuilder
+ ******************************************************************************/
+
+/**
+ * @brief Rebuilds the airwires of a board in the background
+ *
+ * Scheduled net signals are collected until control returns to the event
+ * loop, then the airwires of each of them are built in a worker thread (see
+ * librepcb::project::BoardAirWiresBuilder). There is at most one running job
+ * per net signal. If a net signal is scheduled again while its job is still
+ * running, the next job is started as soon as the running one has finished,
+ * so a burst of modifications (e.g. while dragging items) leads to only a few
+ * rebuilds. The results are applied with
+ * librepcb::project::Board::setAirWires() in the thread of the board.
+ */
+class BoardAirWiresRebuilder final : public QObject {
+  Q_OBJECT
+
+public:
+  // Types
+  typedef QVector<QPair<Point, Point>> AirWires;
+
+  // Constructors / Destructor
+  BoardAirWiresRebuilder()                                    = delete;
+  BoardAirWiresRebuilder(const BoardAirWiresRebuilder& other) = delete;
+  explicit BoardAirWiresRebuilder(Board& board) noexcept;
+  ~BoardAirWiresRebuilder() noexcept;
+
+  // Getters
+  bool isBusy() const noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Schedule rebuilding the airwires of some net signals
+   *
+   * @param netsignals  The net signals to rebuild. Net signals which are not
+   *                    (or no longer) added to the circuit get their airwires
+   *                    removed.
+   */
+  void startRebuild(const QSet<NetSignal*>& netsignals) noexcept;
+
+  /**
+   * @brief Cancel scheduled and running rebuilds of some net signals
+   *
+   * Used when the airwires of these net signals are rebuilt synchronously,
+   * otherwise outdated results could overwrite the new airwires.
+   */
+  void cancel(const QSet<NetSignal*>& netsignals) noexcept;
+
+  /**
+   * @brief Cancel all scheduled and running rebuilds
+   */
+  void cancelAll() noexcept;
+
+  // Operator Overloadings
+  BoardAirWiresRebuilder& operator=(const BoardAirWiresRebuilder& rhs) = delete;
+
+signals:
+  void finished();
+
+private:  // Methods
+  void startScheduledJobs() noexcept;
+  void jobFinished(NetSignal*                 netsignal,
+                   const QPointer<NetSignal>& guard) noexcept;
+
+private:  // Data
+  Board&           mBoard;
+  QSet<NetSignal*> mScheduledNetSignals;
+  QTimer           mScheduleTimer;
+
+  /// The running jobs (at most one per net signal)
+  QHash<NetSignal*, QFutureWatcher<AirWires>*> mRunningJobs;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDAIRWIRESREBUILDER_H
@@ -22,21 +22,10 @@
  ******************************************************************************/
 #include "boardplanefragmentsbuilder.h"
 
-#include "items/bi_device.h"
-#include "items/bi_footprint.h"
-#include "items/bi_footprintpad.h"
-#include "items/bi_hole.h"
-#include "items/bi_netline.h"
-#include "items/bi_netpoint.h"
-#include "items/bi_netsegment.h"
+#include "board.h"
 #include "items/bi_plane.h"
-#include "items/bi_polygon.h"
-#include "items/bi_via.h"
 
-#include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/common/utils/clipperhelpers.h>
-#include <librepcb/library/pkg/footprint.h>
-#include <librepcb/library/pkg/footprintpad.h>
 
 #include <QtCore>
 
@@ -50,13 +39,47 @@ namespace project {
  *  Constructors / Destructor
  ******************************************************************************/
 
-BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept
-  : mPlane(plane) {
+BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(
+    const BI_Plane&                          plane,
+    std::shared_ptr<BoardPlaneObstacleCache> cache) noexcept
+  : mPlaneOutline(plane.getOutline()),
+    mLayerName(plane.getLayerName()),
+    mNetSignal(&plane.getNetSignal()),
+    mConnectStyle(plane.getConnectStyle()),
+    mMinWidth(plane.getMinWidth()),
+    mMinClearance(plane.getMinClearance()),
+    mKeepOrphans(plane.getKeepOrphans()),
+    mCache(cache) {
+  // other planes
+  foreach (const BI_Plane* other, plane.getBoard().getPlanes()) {
+    if (other == &plane) continue;
+    if (*other < plane) continue;  // ignore planes with lower priority
+    if (other->getLayerName() != plane.getLayerName()) continue;
+    if (&other->getNetSignal() == &plane.getNetSignal()) continue;
+    mOtherPlanes.append(other);
+    mFragmentsOfPlanes.insert(other, other->getFragments());
+  }
+
+  // holes, pads, vias, netlines and board outline
+  if (!mCache) {
+    mCache = std::make_shared<BoardPlaneObstacleCache>(plane.getBoard(),
+                                                       maxArcTolerance());
+  }
+  mCache->prepare(mLayerName, mMinClearance);
 }
 
 BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept {
 }
 
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void BoardPlaneFragmentsBuilder::setFragmentsOfPlane(
+    const BI_Plane* plane, const QVector<Path>& fragments) noexcept {
+  mFragmentsOfPlanes.insert(plane, fragments);
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -64,12 +87,14 @@ BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept {
 QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() noexcept {
   try {
     mResult.clear();
+    mConnectedNetSignalAreas.clear();
+    mObstacles = mCache->getObstacles(mLayerName, mMinClearance);  // can throw
     addPlaneOutline();
     clipToBoardOutline();
     subtractOtherObjects();
     ensureMinimumWidth();
     flattenResult();
-    if (!mPlane.getKeepOrphans()) {
+    if (!mKeepOrphans) {
       removeOrphans();
     }
     return ClipperHelpers::convert(mResult);
@@ -80,46 +105,43 @@ QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+bool BoardPlaneFragmentsBuilder::dependsOn(const BI_Plane& plane,
+                                           const BI_Plane& other) noexcept {
+  // same conditions as in subtractOtherObjects()
+  if (&other == &plane) return false;
+  if (other < plane) return false;
+  if (other.getLayerName() != plane.getLayerName()) return false;
+  if (&other.getNetSignal() == &plane.getNetSignal()) return false;
+
+  // the fragments of the other plane are always within its outline, so they
+  // can only affect this plane if the outlines are closer than the clearance
+  ClipperLib::IntRect rect1 = ClipperHelpers::getBoundingRect(ClipperLib::Paths{
+      ClipperHelpers::convert(plane.getOutline(), maxArcTolerance())});
+  ClipperLib::IntRect rect2 = ClipperHelpers::getBoundingRect(ClipperLib::Paths{
+      ClipperHelpers::convert(other.getOutline(), maxArcTolerance())});
+  ClipperLib::cInt clearance = plane.getMinClearance()->toNm() + 1;
+  rect2.left -= clearance;
+  rect2.top -= clearance;
+  rect2.right += clearance;
+  rect2.bottom += clearance;
+  return ClipperHelpers::intersects(rect1, rect2);
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
 void BoardPlaneFragmentsBuilder::addPlaneOutline() {
-  mResult.push_back(
-      ClipperHelpers::convert(mPlane.getOutline(), maxArcTolerance()));
+  mResult.push_back(ClipperHelpers::convert(mPlaneOutline, maxArcTolerance()));
 }
 
 void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
-  // determine board area
-  ClipperLib::Paths   boardArea;
-  ClipperLib::Clipper boardAreaClipper;
-  foreach (const BI_Polygon* polygon, mPlane.getBoard().getPolygons()) {
-    if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
-      ClipperLib::Path path = ClipperHelpers::convert(
-          polygon->getPolygon().getPath(), maxArcTolerance());
-      boardAreaClipper.AddPath(path, ClipperLib::ptSubject, true);
-    }
-  }
-  foreach (const BI_Device* device, mPlane.getBoard().getDeviceInstances()) {
-    const BI_Footprint& footprint = device->getFootprint();
-    for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
-      if (polygon.getLayerName() == GraphicsLayer::sBoardOutlines) {
-        Path path = polygon.getPath();
-        path.rotate(footprint.getRotation());
-        if (footprint.getIsMirrored()) path.mirror(Qt::Horizontal);
-        path.translate(footprint.getPosition());
-        ClipperLib::Path clipperPath =
-            ClipperHelpers::convert(path, maxArcTolerance());
-        boardAreaClipper.AddPath(clipperPath, ClipperLib::ptSubject, true);
-      }
-    }
-  }
-  boardAreaClipper.Execute(ClipperLib::ctXor, boardArea, ClipperLib::pftEvenOdd,
-                           ClipperLib::pftEvenOdd);
-
-  // perform clearance offset
-  ClipperHelpers::offset(boardArea, -mPlane.getMinClearance(),
-                         maxArcTolerance());  // can throw
+  // board area with clearance offset already applied
+  const ClipperLib::Paths& boardArea = mObstacles->boardArea;
 
   // if we have no board area, abort here
   if (boardArea.empty()) return;
@@ -137,74 +159,26 @@ void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
   c.AddPaths(mResult, ClipperLib::ptSubject, true);
 
   // subtract other planes
-  foreach (const BI_Plane* plane, mPlane.getBoard().getPlanes()) {
-    if (plane == &mPlane) continue;
-    if (*plane < mPlane) continue;  // ignore planes with lower priority
-    if (plane->getLayerName() != mPlane.getLayerName()) continue;
-    if (&plane->getNetSignal() == &mPlane.getNetSignal()) continue;
-    ClipperLib::Paths paths =
-        ClipperHelpers::convert(plane->getFragments(), maxArcTolerance());
-    ClipperHelpers::offset(paths, *mPlane.getMinClearance(),
+  foreach (const BI_Plane* plane, mOtherPlanes) {
+    ClipperLib::Paths paths = ClipperHelpers::convert(
+        mFragmentsOfPlanes.value(plane), maxArcTolerance());
+    ClipperHelpers::offset(paths, *mMinClearance,
                            maxArcTolerance());  // can throw
     c.AddPaths(paths, ClipperLib::ptClip, true);
   }
 
-  // subtract holes and pads from devices
-  foreach (const BI_Device* device, mPlane.getBoard().getDeviceInstances()) {
-    for (const Hole& hole :
-         device->getFootprint().getLibFootprint().getHoles()) {
-      Point pos = device->getFootprint().mapToScene(hole.getPosition());
-      PositiveLength dia(hole.getDiameter() + mPlane.getMinClearance() * 2);
-      Path           path = Path::circle(dia).translated(pos);
-      c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
-                ClipperLib::ptClip, true);
+  // subtract holes, pads, vias and netlines
+  typedef BoardPlaneObstacleCache::ItemType ItemType;
+  foreach (const BoardPlaneObstacleCache::Item& item, mObstacles->items) {
+    bool sameNetSignal = (item.netSignal == mNetSignal);
+    if (sameNetSignal && (item.type != ItemType::Hole)) {
+      mConnectedNetSignalAreas.push_back(item.outline);
     }
-    foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
-      if (!pad->isOnLayer(*mPlane.getLayerName())) continue;
-      if (pad->getCompSigInstNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path =
-            ClipperHelpers::convert(pad->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
-      }
-      c.AddPath(createPadCutOut(*pad), ClipperLib::ptClip, true);
-    }
-  }
-
-  // subtract board holes
-  for (const BI_Hole* hole : mPlane.getBoard().getHoles()) {
-    PositiveLength dia(hole->getHole().getDiameter() +
-                       mPlane.getMinClearance() * 2);
-    Path path = Path::circle(dia).translated(hole->getHole().getPosition());
-    c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
-              ClipperLib::ptClip, true);
-  }
-
-  // subtract net segment items
-  foreach (const BI_NetSegment* netsegment,
-           mPlane.getBoard().getNetSegments()) {
-    // subtract vias
-    foreach (const BI_Via* via, netsegment->getVias()) {
-      if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path =
-            ClipperHelpers::convert(via->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
-      }
-      c.AddPath(createViaCutOut(*via), ClipperLib::ptClip, true);
-    }
-
-    // subtract netlines
-    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
-      if (netline->getLayer().getName() != mPlane.getLayerName()) continue;
-      if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path = ClipperHelpers::convert(
-            netline->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
-      } else {
-        ClipperLib::Path path = ClipperHelpers::convert(
-            netline->getSceneOutline(*mPlane.getMinClearance()),
-            maxArcTolerance());
-        c.AddPath(path, ClipperLib::ptClip, true);
-      }
+    bool connectable =
+        (item.type == ItemType::Pad) || (item.type == ItemType::Via);
+    if ((!sameNetSignal) ||
+        (connectable && (mConnectStyle == BI_Plane::ConnectStyle::None))) {
+      c.AddPath(item.cutOut, ClipperLib::ptClip, true);
     }
   }
 
@@ -213,7 +187,7 @@ void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
 }
 
 void BoardPlaneFragmentsBuilder::ensureMinimumWidth() {
-  Length delta = mPlane.getMinWidth() / 2;
+  Length delta = mMinWidth / 2;
   ClipperHelpers::offset(mResult, -delta, maxArcTolerance());  // can throw
   ClipperHelpers::offset(mResult, delta, maxArcTolerance());   // can throw
 }
@@ -246,36 +220,6 @@ void BoardPlaneFragmentsBuilder::removeOrphans() {
                 mResult.end());
 }
 
-/*******************************************************************************
- *  Helper Methods
- ******************************************************************************/
-
-ClipperLib::Path BoardPlaneFragmentsBuilder::createPadCutOut(
-    const BI_FootprintPad& pad) const noexcept {
-  bool differentNetSignal =
-      (pad.getCompSigInstNetSignal() != &mPlane.getNetSignal());
-  if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
-      differentNetSignal) {
-    return ClipperHelpers::convert(
-        pad.getSceneOutline(*mPlane.getMinClearance()), maxArcTolerance());
-  } else {
-    return ClipperLib::Path();
-  }
-}
-
-ClipperLib::Path BoardPlaneFragmentsBuilder::createViaCutOut(
-    const BI_Via& via) const noexcept {
-  bool differentNetSignal =
-      (&via.getNetSignalOfNetSegment() != &mPlane.getNetSignal());
-  if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
-      differentNetSignal) {
-    return ClipperHelpers::convert(
-        via.getSceneOutline(*mPlane.getMinClearance()), maxArcTolerance());
-  } else {
-    return ClipperLib::Path();
-  }
-}
-
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -23,20 +23,23 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "boardplaneobstaclecache.h"
+#include "items/bi_plane.h"
+
 #include <clipper/clipper.hpp>
 #include <librepcb/common/geometry/path.h>
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
 namespace project {
 
-class BI_Plane;
-class BI_Via;
-class BI_FootprintPad;
+class NetSignal;
 
 /*******************************************************************************
  *  Class BoardPlaneFragmentsBuilder
@@ -44,18 +47,67 @@ class BI_FootprintPad;
 
 /**
  * @brief The BoardPlaneFragmentsBuilder class
+ *
+ * All data required from the board is copied in the constructor, so the
+ * constructor must be called in the thread the board lives in, but
+ * #buildFragments() can then be called in any thread, even if the board is
+ * modified in the meantime.
+ *
+ * When building the fragments of multiple planes, pass the same
+ * librepcb::project::BoardPlaneObstacleCache to all of them to avoid
+ * collecting and converting the same geometry again for each plane.
  */
 class BoardPlaneFragmentsBuilder final {
 public:
   // Constructors / Destructor
   BoardPlaneFragmentsBuilder()                                        = delete;
   BoardPlaneFragmentsBuilder(const BoardPlaneFragmentsBuilder& other) = delete;
-  BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept;
+  BoardPlaneFragmentsBuilder(
+      const BI_Plane&                          plane,
+      std::shared_ptr<BoardPlaneObstacleCache> cache = nullptr) noexcept;
   ~BoardPlaneFragmentsBuilder() noexcept;
 
+  // Setters
+
+  /**
+   * @brief Override the fragments of another plane
+   *
+   * By default, the current fragments of other planes are subtracted. This
+   * allows to use not yet applied fragments instead, e.g. when building the
+   * fragments of multiple planes in parallel.
+   *
+   * @param plane       The other plane (only used as key, not accessed).
+   * @param fragments   The fragments to use for that plane.
+   */
+  void setFragmentsOfPlane(const BI_Plane*      plane,
+                           const QVector<Path>& fragments) noexcept;
+
   // General Methods
   QVector<Path> buildFragments() noexcept;
 
+  // Static Methods
+
+  /**
+   * Returns the maximum allowed arc tolerance when flattening arcs. Do not
+   * change this if you don't know exactly what you're doing (it affects all
+   * planes in all existing boards)!
+   */
+  static PositiveLength maxArcTolerance() noexcept {
+    return PositiveLength(5000);
+  }
+
+  /**
+   * @brief Check whether the fragments of a plane depend on another plane
+   *
+   * @param plane   The plane to build the fragments for.
+   * @param other   Another plane of the same board.
+   *
+   * @retval true   If the fragments of `other` might be subtracted from the
+   *                fragments of `plane`.
+   * @retval false  If the fragments of `plane` are independent of `other`.
+   */
+  static bool dependsOn(const BI_Plane& plane, const BI_Plane& other) noexcept;
+
   // Operator Overloadings
   BoardPlaneFragmentsBuilder& operator=(const BoardPlaneFragmentsBuilder& rhs) =
       delete;
@@ -68,21 +120,21 @@ private:  // Methods
   void flattenResult();
   void removeOrphans();
 
-  // Helper Methods
-  ClipperLib::Path createPadCutOut(const BI_FootprintPad& pad) const noexcept;
-  ClipperLib::Path createViaCutOut(const BI_Via& via) const noexcept;
-
-  /**
-   * Returns the maximum allowed arc tolerance when flattening arcs. Do not
-   * change this if you don't know exactly what you're doing (it affects all
-   * planes in all existing boards)!
-   */
-  static PositiveLength maxArcTolerance() noexcept {
-    return PositiveLength(5000);
-  }
+private:  // Data (copied from the board)
+  Path                                     mPlaneOutline;
+  GraphicsLayerName                        mLayerName;
+  const NetSignal*                         mNetSignal;  ///< Not accessed
+  BI_Plane::ConnectStyle                   mConnectStyle;
+  UnsignedLength                           mMinWidth;
+  UnsignedLength                           mMinClearance;
+  bool                                     mKeepOrphans;
+  QList<const BI_Plane*>                   mOtherPlanes;  ///< Not accessed
+  QHash<const BI_Plane*, QVector<Path>>    mFragmentsOfPlanes;
+  std::shared_ptr<BoardPlaneObstacleCache> mCache;
+
+private:  // Data (used while building)
+  std::shared_ptr<const BoardPlaneObstacleCache::Obstacles> mObstacles;
 
-private:  // Data
-  BI_Plane&         mPlane;
   ClipperLib::Paths mConnectedNetSignalAreas;
   ClipperLib::Paths mResult;
 };
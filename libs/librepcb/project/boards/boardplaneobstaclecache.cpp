@@ -0,0 +1,189 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardplaneobstaclecache.h"
+
+#include "board.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_hole.h"
+#include "items/bi_netline.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_polygon.h"
+#include "items/bi_via.h"
+
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/library/pkg/footprint.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardPlaneObstacleCache::BoardPlaneObstacleCache(
+    const Board& board, const PositiveLength& maxArcTolerance) noexcept
+  : mBoard(board),
+    mMaxArcTolerance(maxArcTolerance),
+    mBoardOutlines(),
+    mBoardAreaMutex(),
+    mBoardAreaValid(false),
+    mBoardArea(),
+    mEntries() {
+  foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+    if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
+      mBoardOutlines.append(polygon->getPolygon().getPath());
+    }
+  }
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    const BI_Footprint& footprint = device->getFootprint();
+    for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
+      if (polygon.getLayerName() == GraphicsLayer::sBoardOutlines) {
+        Path path = polygon.getPath();
+        path.rotate(footprint.getRotation());
+        if (footprint.getIsMirrored()) path.mirror(Qt::Horizontal);
+        path.translate(footprint.getPosition());
+        mBoardOutlines.append(path);
+      }
+    }
+  }
+}
+
+BoardPlaneObstacleCache::~BoardPlaneObstacleCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardPlaneObstacleCache::prepare(
+    const GraphicsLayerName& layer, const UnsignedLength& clearance) noexcept {
+  Key key(*layer, clearance->toNm());
+  if (mEntries.contains(key)) {
+    return;
+  }
+
+  std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+  entry->clearance             = *clearance;
+
+  // holes and pads from devices
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    for (const Hole& hole :
+         device->getFootprint().getLibFootprint().getHoles()) {
+      Point pos = device->getFootprint().mapToScene(hole.getPosition());
+      PositiveLength dia(hole.getDiameter() + clearance * 2);
+      entry->snapshots.append(ItemSnapshot{ItemType::Hole, nullptr, Path(),
+                                           Path::circle(dia).translated(pos)});
+    }
+    foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+      if (!pad->isOnLayer(*layer)) continue;
+      entry->snapshots.append(ItemSnapshot{
+          ItemType::Pad, pad->getCompSigInstNetSignal(),
+          pad->getSceneOutline(), pad->getSceneOutline(*clearance)});
+    }
+  }
+
+  // board holes
+  for (const BI_Hole* hole : mBoard.getHoles()) {
+    PositiveLength dia(hole->getHole().getDiameter() + clearance * 2);
+    entry->snapshots.append(ItemSnapshot{
+        ItemType::Hole, nullptr, Path(),
+        Path::circle(dia).translated(hole->getHole().getPosition())});
+  }
+
+  // net segment items
+  foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
+    foreach (const BI_Via* via, netsegment->getVias()) {
+      entry->snapshots.append(
+          ItemSnapshot{ItemType::Via, &netsegment->getNetSignal(),
+                       via->getSceneOutline(),
+                       via->getSceneOutline(*clearance)});
+    }
+    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+      if (netline->getLayer().getName() != layer) continue;
+      entry->snapshots.append(
+          ItemSnapshot{ItemType::NetLine, &netsegment->getNetSignal(),
+                       netline->getSceneOutline(),
+                       netline->getSceneOutline(*clearance)});
+    }
+  }
+
+  mEntries.insert(key, entry);
+}
+
+std::shared_ptr<const BoardPlaneObstacleCache::Obstacles>
+BoardPlaneObstacleCache::getObstacles(const GraphicsLayerName& layer,
+                                      const UnsignedLength& clearance) const {
+  std::shared_ptr<Entry> entry = mEntries.value(Key(*layer, clearance->toNm()));
+  if (!entry) {
+    throw LogicError(__FILE__, __LINE__);  // prepare() was not called
+  }
+
+  // Only block other threads which need the same obstacles
+  QMutexLocker lock(&entry->mutex);
+  if (!entry->obstacles) {
+    std::shared_ptr<Obstacles> obstacles = std::make_shared<Obstacles>();
+    obstacles->boardArea                 = getBoardArea();  // can throw
+    ClipperHelpers::offset(obstacles->boardArea, -entry->clearance,
+                           mMaxArcTolerance);  // can throw
+    foreach (const ItemSnapshot& snapshot, entry->snapshots) {
+      obstacles->items.append(
+          Item{snapshot.type, snapshot.netSignal,
+               ClipperHelpers::convert(snapshot.outline, mMaxArcTolerance),
+               ClipperHelpers::convert(snapshot.cutOut, mMaxArcTolerance)});
+    }
+    entry->obstacles = obstacles;
+  }
+  return entry->obstacles;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+const ClipperLib::Paths& BoardPlaneObstacleCache::getBoardArea() const {
+  QMutexLocker lock(&mBoardAreaMutex);
+  if (!mBoardAreaValid) {
+    ClipperLib::Clipper clipper;
+    clipper.AddPaths(ClipperHelpers::convert(mBoardOutlines, mMaxArcTolerance),
+                     ClipperLib::ptSubject, true);
+    clipper.Execute(ClipperLib::ctXor, mBoardArea, ClipperLib::pftEvenOdd,
+                    ClipperLib::pftEvenOdd);
+    mBoardAreaValid = true;
+  }
+  return mBoardArea;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
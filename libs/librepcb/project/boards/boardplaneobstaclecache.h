@@ -0,0 +1,131 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDPLANEOBSTACLECACHE_H
+#define LIBREPCB_PROJECT_BOARDPLANEOBSTACLECACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <clipper/clipper.hpp>
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/graphics/graphicslayername.h>
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetSignal;
+
+/*******************************************************************************
+ *  Class BoardPlaneObstacleCache
+ ******************************************************************************/
+
+/**
+ * @brief Geometry of a board which planes need to be clipped to or need to be
+ *        subtracted from planes
+ *
+ * Collecting and converting the geometry of all items of a board is expensive,
+ * but only depends on the layer and the clearance of a plane. So when
+ * rebuilding all planes of a board, this is done only once per layer and
+ * clearance by sharing one cache between all
+ * librepcb::project::BoardPlaneFragmentsBuilder objects. The cache is not
+ * updated when the board is modified, so a new cache is needed for each
+ * rebuild.
+ *
+ * The data from the board is copied by #prepare(), which therefore has to be
+ * called in the thread of the board. The expensive conversion is done lazily
+ * by #getObstacles(), which may be called from any thread. But it must not be
+ * called while #prepare() is called in another thread.
+ */
+class BoardPlaneObstacleCache final {
+public:
+  // Types
+  enum class ItemType { Hole, Pad, Via, NetLine };
+  struct Item {
+    ItemType         type;
+    const NetSignal* netSignal;  ///< Only used as key, not accessed
+    ClipperLib::Path outline;    ///< Outline of the copper (empty for holes)
+    ClipperLib::Path cutOut;     ///< Outline expanded by the clearance
+  };
+  struct Obstacles {
+    ClipperLib::Paths boardArea;  ///< Board area shrunk by the clearance
+    QVector<Item>     items;      ///< Items on the layer, in board order
+  };
+
+  // Constructors / Destructor
+  BoardPlaneObstacleCache()                                     = delete;
+  BoardPlaneObstacleCache(const BoardPlaneObstacleCache& other) = delete;
+  BoardPlaneObstacleCache(const Board&          board,
+                          const PositiveLength& maxArcTolerance) noexcept;
+  ~BoardPlaneObstacleCache() noexcept;
+
+  // General Methods
+  void prepare(const GraphicsLayerName& layer,
+               const UnsignedLength&    clearance) noexcept;
+  std::shared_ptr<const Obstacles> getObstacles(
+      const GraphicsLayerName& layer, const UnsignedLength& clearance) const;
+
+  // Operator Overloadings
+  BoardPlaneObstacleCache& operator=(const BoardPlaneObstacleCache& rhs) =
+      delete;
+
+private:  // Types
+  typedef QPair<QString, LengthBase_t> Key;
+  struct ItemSnapshot {
+    ItemType         type;
+    const NetSignal* netSignal;
+    Path             outline;
+    Path             cutOut;
+  };
+  struct Entry {
+    Length                           clearance;
+    QVector<ItemSnapshot>            snapshots;
+    QMutex                           mutex;
+    std::shared_ptr<const Obstacles> obstacles;
+  };
+
+private:  // Methods
+  const ClipperLib::Paths& getBoardArea() const;
+
+private:  // Data
+  const Board&                       mBoard;
+  PositiveLength                     mMaxArcTolerance;
+  QVector<Path>                      mBoardOutlines;
+  mutable QMutex                     mBoardAreaMutex;
+  mutable bool                       mBoardAreaValid;
+  mutable ClipperLib::Paths          mBoardArea;  ///< Not yet shrunk
+  QHash<Key, std::shared_ptr<Entry>> mEntries;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDPLANEOBSTACLECACHE_H
@@ -0,0 +1,206 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardplanesrebuilder.h"
+
+#include "board.h"
+#include "boardplanefragmentsbuilder.h"
+#include "boardplaneobstaclecache.h"
+#include "items/bi_plane.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Types
+ ******************************************************************************/
+
+struct BoardPlanesRebuilder::Job {
+  /// The planes to build, sorted by priority. They are only accessed in the
+  /// thread of the board since they might be modified or deleted meanwhile.
+  QList<BI_Plane*>                                     planes;
+  QVector<std::shared_ptr<BoardPlaneFragmentsBuilder>> builders;
+  QVector<QVector<int>>                                dependencies;
+  QVector<int>                                         passes;
+  int                                                  passCount;
+  QVector<QVector<Path>>                               fragments;
+  QAtomicInt                                           cancelled;
+};
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardPlanesRebuilder::BoardPlanesRebuilder(Board& board) noexcept
+  : QObject(nullptr), mBoard(board), mJob(), mWatcher(), mRestartTimer() {
+  mRestartTimer.setSingleShot(true);
+  mRestartTimer.setInterval(0);
+  connect(&mRestartTimer, &QTimer::timeout, this,
+          &BoardPlanesRebuilder::startRebuild);
+  connect(&mWatcher, &QFutureWatcher<void>::finished, this,
+          &BoardPlanesRebuilder::jobFinished);
+}
+
+BoardPlanesRebuilder::~BoardPlanesRebuilder() noexcept {
+  // A job doesn't access the board, so there's no need to wait for it
+  cancel();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardPlanesRebuilder::rebuild() noexcept {
+  cancel();
+  std::shared_ptr<Job> job = createJob();
+  runJob(*job);
+  applyResults(*job);
+}
+
+void BoardPlanesRebuilder::startRebuild() noexcept {
+  cancel();
+  mJob = createJob();
+  std::shared_ptr<Job> job = mJob;  // keeps the job alive until it's finished
+  mWatcher.setFuture(QtConcurrent::run([job]() { runJob(*job); }));
+}
+
+void BoardPlanesRebuilder::restartIfBusy() noexcept {
+  if (mJob) {
+    mRestartTimer.start();
+  }
+}
+
+void BoardPlanesRebuilder::finish() noexcept {
+  if (mRestartTimer.isActive()) {
+    rebuild();  // the results of the running job are outdated
+  } else if (mJob) {
+    mWatcher.waitForFinished();
+    jobFinished();
+  }
+}
+
+void BoardPlanesRebuilder::cancel() noexcept {
+  mRestartTimer.stop();
+  if (mJob) {
+    mJob->cancelled.store(1);
+    mJob.reset();
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+std::shared_ptr<BoardPlanesRebuilder::Job> BoardPlanesRebuilder::createJob()
+    const noexcept {
+  std::shared_ptr<Job> job = std::make_shared<Job>();
+  job->planes              = mBoard.getPlanes();
+  std::sort(job->planes.begin(), job->planes.end(),
+            [](const BI_Plane* p1, const BI_Plane* p2) {
+              return !(*p1 < *p2);
+            });  // sort by priority (highest priority first)
+
+  job->dependencies.resize(job->planes.count());
+  job->passes.fill(0, job->planes.count());
+  job->passCount = job->planes.isEmpty() ? 0 : 1;
+  job->fragments.resize(job->planes.count());
+  // the obstacles are the same for all planes on the same layer with the same
+  // clearance, so they are collected and converted only once
+  auto cache = std::make_shared<BoardPlaneObstacleCache>(
+      mBoard, BoardPlaneFragmentsBuilder::maxArcTolerance());
+  for (int i = 0; i < job->planes.count(); ++i) {
+    // the builder copies all the data it needs from the board
+    job->builders.append(
+        std::make_shared<BoardPlaneFragmentsBuilder>(*job->planes[i], cache));
+    for (int k = 0; k < i; ++k) {
+      if (BoardPlaneFragmentsBuilder::dependsOn(*job->planes[i],
+                                                *job->planes[k])) {
+        job->dependencies[i].append(k);
+        job->passes[i] = qMax(job->passes[i], job->passes[k] + 1);
+      }
+    }
+    job->passCount = qMax(job->passCount, job->passes[i] + 1);
+  }
+  return job;
+}
+
+void BoardPlanesRebuilder::runJob(Job& job) noexcept {
+  for (int pass = 0; pass < job.passCount; ++pass) {
+    if (job.cancelled.load()) {
+      return;
+    }
+    QVector<int>                    indices;
+    QVector<QFuture<QVector<Path>>> futures;
+    for (int i = 0; i < job.planes.count(); ++i) {
+      if (job.passes[i] != pass) continue;
+      std::shared_ptr<BoardPlaneFragmentsBuilder> builder = job.builders[i];
+      foreach (int k, job.dependencies[i]) {
+        builder->setFragmentsOfPlane(job.planes[k], job.fragments[k]);
+      }
+      indices.append(i);
+      // the job outlives the workers since their results are awaited below
+      futures.append(QtConcurrent::run([&job, builder]() {
+        if (job.cancelled.load()) {
+          return QVector<Path>();  // don't start building outdated fragments
+        }
+        return builder->buildFragments();
+      }));
+    }
+    for (int n = 0; n < futures.count(); ++n) {
+      job.fragments[indices[n]] = futures[n].result();  // blocks
+    }
+  }
+}
+
+void BoardPlanesRebuilder::applyResults(const Job& job) noexcept {
+  // Planes removed from the board in the meantime are skipped
+  for (int i = 0; i < job.planes.count(); ++i) {
+    if (mBoard.getPlanes().contains(job.planes[i])) {
+      job.planes[i]->setFragments(job.fragments[i]);
+    }
+  }
+}
+
+void BoardPlanesRebuilder::jobFinished() noexcept {
+  // The watcher only reports the job started most recently, but it might
+  // have been cancelled in the meantime
+  if (mJob && (!mJob->cancelled.load())) {
+    std::shared_ptr<Job> job = mJob;
+    mJob.reset();
+    applyResults(*job);
+    mBoard.triggerAirWiresRebuildAsync();
+    emit finished();
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
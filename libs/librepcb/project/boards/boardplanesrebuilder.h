@@ -0,0 +1,143 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
+#define LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+
+/*******************************************************************************
+ *  Class BoardPlanesRebuilder
+ ******************************************************************************/
+
+/**
+ * @brief Rebuilds the fragments of all planes of a board
+ *
+ * The planes are built in multiple passes. Each plane needs the new fragments
+ * of all planes it depends on (see
+ * librepcb::project::BoardPlaneFragmentsBuilder::dependsOn()), which are always
+ * sorted before it. Each pass only depends on the results of previous passes,
+ * so all planes of the same pass are built in parallel. Planes with the same
+ * priority use the old fragments of each other, just like when building one
+ * plane after another. Therefore the results are applied at the very end.
+ *
+ * The rebuild can either be done blocking with #rebuild(), or asynchronously
+ * with #startRebuild(). In the latter case, the geometry of the board is
+ * copied and the results are applied later in the thread of the board, as
+ * soon as they are available. Starting a new rebuild cancels a running one
+ * since its results would be outdated anyway.
+ */
+class BoardPlanesRebuilder final : public QObject {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  BoardPlanesRebuilder()                                  = delete;
+  BoardPlanesRebuilder(const BoardPlanesRebuilder& other) = delete;
+  explicit BoardPlanesRebuilder(Board& board) noexcept;
+  ~BoardPlanesRebuilder() noexcept;
+
+  // Getters
+  bool isBusy() const noexcept { return mJob != nullptr; }
+
+  // General Methods
+
+  /**
+   * @brief Rebuild all planes and block until they are rebuilt
+   *
+   * A running asynchronous rebuild is cancelled.
+   */
+  void rebuild() noexcept;
+
+  /**
+   * @brief Start rebuilding all planes in the background
+   *
+   * A running asynchronous rebuild is cancelled. The #finished() signal is
+   * emitted after the new fragments have been applied to the planes.
+   */
+  void startRebuild() noexcept;
+
+  /**
+   * @brief Restart a running asynchronous rebuild
+   *
+   * Should be called whenever the board was modified. Does nothing if no
+   * rebuild is running, otherwise the running rebuild is restarted from the
+   * event loop, so multiple modifications in a row lead to only one restart.
+   */
+  void restartIfBusy() noexcept;
+
+  /**
+   * @brief Finish a running asynchronous rebuild immediately
+   *
+   * Blocks until the running rebuild is finished and applies its results. If
+   * the board was modified since the rebuild was started, all planes are
+   * rebuilt blocking instead. Does nothing if no rebuild is running.
+   *
+   * Must be called before the planes are used for output, e.g. printing.
+   */
+  void finish() noexcept;
+
+  /**
+   * @brief Cancel a running asynchronous rebuild
+   *
+   * The planes are then left unchanged.
+   */
+  void cancel() noexcept;
+
+  // Operator Overloadings
+  BoardPlanesRebuilder& operator=(const BoardPlanesRebuilder& rhs) = delete;
+
+signals:
+  void finished();
+
+private:  // Methods
+  struct Job;
+  std::shared_ptr<Job> createJob() const noexcept;
+  static void          runJob(Job& job) noexcept;
+  void                 applyResults(const Job& job) noexcept;
+  void                 jobFinished() noexcept;
+
+private:  // Data
+  Board&               mBoard;
+  std::shared_ptr<Job> mJob;  ///< The running asynchronous job (if any)
+  QFutureWatcher<void> mWatcher;
+  QTimer               mRestartTimer;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
@@ -61,11 +61,13 @@ bool CmdBoardDesignRulesModify::performExecute() {
 
 void CmdBoardDesignRulesModify::performUndo() {
   mBoard.getDesignRules() = mOldRules;
+  mBoard.markAllModified();
   emit mBoard.attributesChanged();
 }
 
 void CmdBoardDesignRulesModify::performRedo() {
   mBoard.getDesignRules() = mNewRules;
+  mBoard.markAllModified();
   emit mBoard.attributesChanged();
 }
 
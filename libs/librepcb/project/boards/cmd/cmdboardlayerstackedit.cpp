@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "cmdboardlayerstackedit.h"
 
+#include "../board.h"
 #include "../boardlayerstack.h"
 
 #include <QtCore>
@@ -69,10 +70,12 @@ bool CmdBoardLayerStackEdit::performExecute() {
 
 void CmdBoardLayerStackEdit::performUndo() {
   mLayerStack.setInnerLayerCount(mOldInnerLayerCount);
+  mLayerStack.getBoard().markAllModified();
 }
 
 void CmdBoardLayerStackEdit::performRedo() {
   mLayerStack.setInnerLayerCount(mNewInnerLayerCount);
+  mLayerStack.getBoard().markAllModified();
 }
 
 /*******************************************************************************
@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "cmdboardnetpointedit.h"
 
+#include "../board.h"
 #include "../items/bi_netpoint.h"
 
 #include <QtCore>
@@ -86,10 +87,14 @@ bool CmdBoardNetPointEdit::performExecute() {
 
 void CmdBoardNetPointEdit::performUndo() {
   mNetPoint.setPosition(mOldPos);
+  mNetPoint.getBoard().markNetSignalModified(
+      &mNetPoint.getNetSignalOfNetSegment());
 }
 
 void CmdBoardNetPointEdit::performRedo() {
   mNetPoint.setPosition(mNewPos);
+  mNetPoint.getBoard().markNetSignalModified(
+      &mNetPoint.getNetSignalOfNetSegment());
 }
 
 /*******************************************************************************
@@ -72,10 +72,12 @@ bool CmdBoardNetSegmentAdd::performExecute() {
 
 void CmdBoardNetSegmentAdd::performUndo() {
   mBoard.removeNetSegment(*mNetSegment);  // can throw
+  mBoard.markNetSignalModified(&mNetSignal);
 }
 
 void CmdBoardNetSegmentAdd::performRedo() {
   mBoard.addNetSegment(*mNetSegment);  // can throw
+  mBoard.markNetSignalModified(&mNetSignal);
 }
 
 /*******************************************************************************
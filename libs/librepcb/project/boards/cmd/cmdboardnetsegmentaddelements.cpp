@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "cmdboardnetsegmentaddelements.h"
 
+#include "../board.h"
 #include "../items/bi_netline.h"
 #include "../items/bi_netpoint.h"
 #include "../items/bi_netsegment.h"
@@ -97,10 +98,12 @@ bool CmdBoardNetSegmentAddElements::performExecute() {
 
 void CmdBoardNetSegmentAddElements::performUndo() {
   mNetSegment.removeElements(mVias, mNetPoints, mNetLines);  // can throw
+  mNetSegment.getBoard().markNetSignalModified(&mNetSegment.getNetSignal());
 }
 
 void CmdBoardNetSegmentAddElements::performRedo() {
   mNetSegment.addElements(mVias, mNetPoints, mNetLines);  // can throw
+  mNetSegment.getBoard().markNetSignalModified(&mNetSegment.getNetSignal());
 }
 
 /*******************************************************************************
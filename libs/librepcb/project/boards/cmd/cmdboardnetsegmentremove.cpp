@@ -59,10 +59,12 @@ bool CmdBoardNetSegmentRemove::performExecute() {
 
 void CmdBoardNetSegmentRemove::performUndo() {
   mBoard.addNetSegment(mNetSegment);  // can throw
+  mBoard.markNetSignalModified(&mNetSegment.getNetSignal());
 }
 
 void CmdBoardNetSegmentRemove::performRedo() {
   mBoard.removeNetSegment(mNetSegment);  // can throw
+  mBoard.markNetSignalModified(&mNetSegment.getNetSignal());
 }
 
 /*******************************************************************************
@@ -75,10 +75,12 @@ bool CmdBoardNetSegmentRemoveElements::performExecute() {
 
 void CmdBoardNetSegmentRemoveElements::performUndo() {
   mNetSegment.addElements(mVias, mNetPoints, mNetLines);  // can throw
+  mNetSegment.getBoard().markNetSignalModified(&mNetSegment.getNetSignal());
 }
 
 void CmdBoardNetSegmentRemoveElements::performRedo() {
   mNetSegment.removeElements(mVias, mNetPoints, mNetLines);  // can throw
+  mNetSegment.getBoard().markNetSignalModified(&mNetSegment.getNetSignal());
 }
 
 /*******************************************************************************
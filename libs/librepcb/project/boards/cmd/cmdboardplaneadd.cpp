@@ -57,10 +57,12 @@ bool CmdBoardPlaneAdd::performExecute() {
 
 void CmdBoardPlaneAdd::performUndo() {
   mBoard.removePlane(mPlane);
+  mBoard.markNetSignalModified(&mPlane.getNetSignal());
 }
 
 void CmdBoardPlaneAdd::performRedo() {
   mBoard.addPlane(mPlane);
+  mBoard.markNetSignalModified(&mPlane.getNetSignal());
 }
 
 /*******************************************************************************
@@ -166,9 +166,11 @@ void CmdBoardPlaneEdit::performUndo() {
   mPlane.setConnectStyle(mOldConnectStyle);
   mPlane.setPriority(mOldPriority);
   mPlane.setKeepOrphans(mOldKeepOrphans);
+  mPlane.getBoard().markNetSignalModified(mOldNetSignal);
+  mPlane.getBoard().markNetSignalModified(mNewNetSignal);
 
   // rebuild all planes to see the changes
-  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanesAsync();
 }
 
 void CmdBoardPlaneEdit::performRedo() {
@@ -180,9 +182,11 @@ void CmdBoardPlaneEdit::performRedo() {
   mPlane.setConnectStyle(mNewConnectStyle);
   mPlane.setPriority(mNewPriority);
   mPlane.setKeepOrphans(mNewKeepOrphans);
+  mPlane.getBoard().markNetSignalModified(mOldNetSignal);
+  mPlane.getBoard().markNetSignalModified(mNewNetSignal);
 
   // rebuild all planes to see the changes
-  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanesAsync();
 }
 
 /*******************************************************************************
@@ -58,10 +58,12 @@ bool CmdBoardPlaneRemove::performExecute() {
 
 void CmdBoardPlaneRemove::performUndo() {
   mBoard.addPlane(mPlane);  // can throw
+  mBoard.markNetSignalModified(&mPlane.getNetSignal());
 }
 
 void CmdBoardPlaneRemove::performRedo() {
   mBoard.removePlane(mPlane);  // can throw
+  mBoard.markNetSignalModified(&mPlane.getNetSignal());
 }
 
 /*******************************************************************************
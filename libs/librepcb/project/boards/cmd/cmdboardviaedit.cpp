@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "cmdboardviaedit.h"
 
+#include "../board.h"
 #include "../items/bi_via.h"
 
 #include <QtCore>
@@ -117,6 +118,7 @@ void CmdBoardViaEdit::performUndo() {
   mVia.setShape(mOldShape);
   mVia.setSize(mOldSize);
   mVia.setDrillDiameter(mOldDrillDiameter);
+  mVia.getBoard().markNetSignalModified(&mVia.getNetSignalOfNetSegment());
 }
 
 void CmdBoardViaEdit::performRedo() {
@@ -124,6 +126,7 @@ void CmdBoardViaEdit::performRedo() {
   mVia.setShape(mNewShape);
   mVia.setSize(mNewSize);
   mVia.setDrillDiameter(mNewDrillDiameter);
+  mVia.getBoard().markNetSignalModified(&mVia.getNetSignalOfNetSegment());
 }
 
 /*******************************************************************************
@@ -55,10 +55,12 @@ bool CmdDeviceInstanceAdd::performExecute() {
 
 void CmdDeviceInstanceAdd::performUndo() {
   mDeviceInstance.getBoard().removeDeviceInstance(mDeviceInstance);
+  mDeviceInstance.getBoard().markDeviceModified(mDeviceInstance);
 }
 
 void CmdDeviceInstanceAdd::performRedo() {
   mDeviceInstance.getBoard().addDeviceInstance(mDeviceInstance);
+  mDeviceInstance.getBoard().markDeviceModified(mDeviceInstance);
 }
 
 /*******************************************************************************
@@ -58,10 +58,12 @@ bool CmdDeviceInstanceRemove::performExecute() {
 
 void CmdDeviceInstanceRemove::performUndo() {
   mBoard.addDeviceInstance(mDevice);  // can throw
+  mBoard.markDeviceModified(mDevice);
 }
 
 void CmdDeviceInstanceRemove::performRedo() {
   mBoard.removeDeviceInstance(mDevice);  // can throw
+  mBoard.markDeviceModified(mDevice);
 }
 
 /*******************************************************************************
@@ -47,6 +47,7 @@
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -61,12 +62,36 @@ namespace project {
 
 BoardDesignRuleCheck::BoardDesignRuleCheck(Board& board, const Options& options,
                                            QObject* parent) noexcept
-  : QObject(parent), mBoard(board), mOptions(options), mMessages() {
+  : QObject(parent),
+    mBoard(board),
+    mOptions(options),
+    mIncremental(false),
+    mMessages(),
+    mBoardOutlineModified(true),
+    mCacheValid(false) {
 }
 
 BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept {
 }
 
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void BoardDesignRuleCheck::setOptions(const Options& options) noexcept {
+  if (options != mOptions) {
+    mOptions = options;
+    invalidateCache();
+  }
+}
+
+void BoardDesignRuleCheck::setIncremental(bool incremental) noexcept {
+  mIncremental = incremental;
+  if (!mIncremental) {
+    invalidateCache();
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -76,16 +101,66 @@ void BoardDesignRuleCheck::execute() {
   emit progressPercent(5);
 
   mMessages.clear();
+  determineModifications();
+  mCacheValid = false;  // until the check has finished successfully
 
+  // Steps which modify the board need to be done in the main thread
   rebuildPlanes(5, 15);
-  checkCopperBoardClearances(15, 40);
-  checkCopperCopperClearances(40, 70);
-  checkMinimumCopperWidth(70, 72);
-  checkMinimumPthRestring(72, 74);
-  checkMinimumPthDrillDiameter(74, 76);
-  checkMinimumNpthDrillDiameter(76, 78);
-  checkCourtyardClearances(78, 88);
-  checkForMissingConnections(88, 90);
+  rebuildAirWires(15, 17);
+
+  // Build shared data which is then only read by the checks
+  buildCopperPathsCache(17, 35);
+  updateBoardOutlineRestrictedArea();
+
+  // Split the checks into independent work units. Each layer cache is accessed
+  // by only one work unit per check, so they must be created here upfront.
+  QVector<WorkUnit> units;
+  foreach (const GraphicsLayer* layer, mCopperLayers) {
+    CopperLayerCache* cache = &mCopperLayerCaches[layer];
+    units.append(WorkUnit{tr("Check board clearances..."),
+                          20.0 / mCopperLayers.count(),
+                          [this, layer, cache]() {
+                            return checkCopperBoardClearances(*layer, *cache);
+                          }});
+  }
+  foreach (const GraphicsLayer* layer, mCopperLayers) {
+    CopperLayerCache* cache = &mCopperLayerCaches[layer];
+    units.append(WorkUnit{tr("Check copper clearances..."),
+                          30.0 / mCopperLayers.count(),
+                          [this, layer, cache]() {
+                            return checkCopperCopperClearances(*layer, *cache);
+                          }});
+  }
+  units.append(WorkUnit{tr("Check minimum copper width..."), 2,
+                        [this]() { return checkMinimumCopperWidth(); }});
+  units.append(WorkUnit{tr("Check minimum PTH restrings..."), 2,
+                        [this]() { return checkMinimumPthRestring(); }});
+  units.append(WorkUnit{tr("Check minimum PTH drill diameters..."), 2,
+                        [this]() { return checkMinimumPthDrillDiameter(); }});
+  units.append(WorkUnit{tr("Check minimum NPTH drill diameters..."), 2,
+                        [this]() { return checkMinimumNpthDrillDiameter(); }});
+  auto courtyardLayers = mBoard.getLayerStack().getLayers(
+      {GraphicsLayer::sTopCourtyard, GraphicsLayer::sBotCourtyard});
+  foreach (const GraphicsLayer* layer, courtyardLayers) {
+    CourtyardLayerCache* cache = &mCourtyardLayerCaches[layer];
+    units.append(WorkUnit{tr("Check courtyard clearances..."),
+                          10.0 / courtyardLayers.count(),
+                          [this, layer, cache]() {
+                            return checkCourtyardClearances(*layer, *cache);
+                          }});
+  }
+  units.append(WorkUnit{tr("Check for missing connections..."), 2,
+                        [this]() { return checkForMissingConnections(); }});
+
+  // Run them in parallel
+  QVector<Messages> results = executeWorkUnits(units, 35, 95);  // can throw
+  foreach (const Messages& messages, results) {
+    mMessages.append(messages);
+  }
+
+  mModifiedNetSignals.clear();
+  mModifiedDevices.clear();
+  mCacheValid = mIncremental;
 
   emit progressStatus(QString(tr("Finished with %1 message(s)!",
                                  "Count of messages", mMessages.count()))
@@ -98,42 +173,199 @@ void BoardDesignRuleCheck::execute() {
  *  Private Methods
  ******************************************************************************/
 
+QVector<BoardDesignRuleCheck::Messages> BoardDesignRuleCheck::executeWorkUnits(
+    const QVector<WorkUnit>& units, int progressStart, int progressEnd) {
+  qreal totalWeight = 0;
+  foreach (const WorkUnit& unit, units) {
+    totalWeight += unit.weight;
+  }
+
+  // Each work unit writes only into its own result slot, so the slots don't
+  // need to be protected. Only the queue of finished units is shared. It is
+  // reference counted because the workers access it until they return.
+  struct FinishedQueue {
+    QMutex      mutex;
+    QQueue<int> indices;
+    QSemaphore  semaphore;
+  };
+  auto finished = std::make_shared<FinishedQueue>();
+
+  QVector<Messages>                   results(units.count());
+  QVector<std::shared_ptr<Exception>> errors(units.count());
+  Messages*                           resultSlots = results.data();
+  std::shared_ptr<Exception>*         errorSlots  = errors.data();
+  for (int i = 0; i < units.count(); ++i) {
+    const WorkUnit& unit = units.at(i);
+    QtConcurrent::run([&unit, finished, resultSlots, errorSlots, i]() {
+      try {
+        resultSlots[i] = unit.function();
+      } catch (const Exception& e) {
+        errorSlots[i].reset(e.clone());
+      } catch (const std::exception& e) {
+        errorSlots[i].reset(new LogicError(__FILE__, __LINE__, e.what()));
+      }
+      {
+        QMutexLocker lock(&finished->mutex);
+        finished->indices.enqueue(i);
+      }
+      finished->semaphore.release();
+    });
+  }
+
+  // Report progress in the order in which the units have finished. This loop
+  // must not be left before *all* units have finished since they access
+  // the units and the result slots.
+  qreal   finishedWeight = 0;
+  QString lastStatus;
+  for (int n = 0; n < units.count(); ++n) {
+    finished->semaphore.acquire();
+    int i;
+    {
+      QMutexLocker lock(&finished->mutex);
+      i = finished->indices.dequeue();
+    }
+    if (units.at(i).status != lastStatus) {
+      emit progressStatus(units.at(i).status);
+      lastStatus = units.at(i).status;
+    }
+    foreach (const BoardDesignRuleCheckMessage& msg, results.at(i)) {
+      emit progressMessage(msg.getMessage());
+    }
+    finishedWeight += units.at(i).weight;
+    qreal progress = (progressEnd - progressStart) * finishedWeight /
+                     qMax(totalWeight, qreal(1));
+    emit progressPercent(progressStart + static_cast<int>(progress));
+  }
+
+  // Report the first error in the deterministic order of the units
+  foreach (const std::shared_ptr<Exception>& error, errors) {
+    if (error) {
+      error->raise();
+    }
+  }
+  return results;
+}
+
+void BoardDesignRuleCheck::invalidateCache() noexcept {
+  mCacheValid = false;
+  mCachedPlaneFragments.clear();
+  mCachedOutlineRestrictedArea.clear();
+  mCopperLayerCaches.clear();
+  mCourtyardLayerCaches.clear();
+  mCachedPaths.clear();
+}
+
+void BoardDesignRuleCheck::determineModifications() {
+  // Always take the modifications to not accumulate them forever
+  Board::Modifications modifications = mBoard.takeModifications();
+
+  QList<NetSignal*> netsignals =
+      mBoard.getProject().getCircuit().getNetSignals().values();
+  netsignals.append(nullptr);  // also check unconnected copper objects
+  QList<const GraphicsLayer*> copperLayers;
+  foreach (const GraphicsLayer* layer, mBoard.getLayerStack().getAllLayers()) {
+    if (layer->isCopperLayer() && layer->isEnabled()) {
+      copperLayers.append(layer);
+    }
+  }
+
+  if ((!mCacheValid) || modifications.all || (copperLayers != mCopperLayers)) {
+    invalidateCache();
+  }
+
+  // Only the cached results of unmodified items will be reused. Results of
+  // nets and devices which were not checked before are not cached at all,
+  // thus they are always calculated.
+  mModifiedNetSignals   = modifications.netSignals;
+  mModifiedDevices      = modifications.devices;
+  mBoardOutlineModified = true;  // determined later
+  mNetSignals           = netsignals;
+  mCopperLayers         = copperLayers;
+}
+
 void BoardDesignRuleCheck::rebuildPlanes(int progressStart, int progressEnd) {
   Q_UNUSED(progressStart);
   emit progressStatus(tr("Rebuild planes..."));
   mBoard.rebuildAllPlanes();
+
+  // Plane fragments depend on other nets, thus a plane might have changed even
+  // if its own net was not modified.
+  QHash<const BI_Plane*, QVector<Path>> fragments;
+  foreach (const BI_Plane* plane, mBoard.getPlanes()) {
+    fragments.insert(plane, plane->getFragments());
+    auto it = mCachedPlaneFragments.constFind(plane);
+    if ((it == mCachedPlaneFragments.constEnd()) ||
+        (*it != plane->getFragments())) {
+      mModifiedNetSignals.insert(&plane->getNetSignal());
+    }
+  }
+  mCachedPlaneFragments = fragments;
+
   emit progressPercent(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkForMissingConnections(int progressStart,
-                                                      int progressEnd) {
+void BoardDesignRuleCheck::rebuildAirWires(int progressStart,
+                                           int progressEnd) {
   Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check for missing connections..."));
-
-  // No check based on copper paths implemented yet -> return existing airwires
-  // instead.
+  // No check based on copper paths implemented yet -> the existing airwires
+  // are used to check for missing connections, so make them up to date.
   mBoard.forceAirWiresRebuild();
-  foreach (const BI_AirWire* airwire, mBoard.getAirWires()) {
-    QString msg =
-        QString(tr("Missing connection: '%1'", "Placeholder is net name"))
-            .arg(*airwire->getNetSignal().getName());
-    Path location = Path::obround(airwire->getP1(), airwire->getP2(),
-                                  PositiveLength(50000));
-    addMessage(BoardDesignRuleCheckMessage(msg, location));
-  }
-
   emit progressPercent(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkCopperBoardClearances(int progressStart,
-                                                      int progressEnd) {
-  emit progressStatus(tr("Check board clearances..."));
+void BoardDesignRuleCheck::buildCopperPathsCache(int progressStart,
+                                                 int progressEnd) {
+  // Copper without net is always rebuilt and compared with the cached one
+  // since it is modified by many different kinds of items (e.g. polygons
+  // and texts of the board and of footprints).
+  QVector<QPair<const GraphicsLayer*, const NetSignal*>> keys;
+  QHash<const GraphicsLayer*, QHash<const NetSignal*, ClipperLib::Paths>> cache;
+  foreach (const GraphicsLayer* layer, mCopperLayers) {
+    foreach (const NetSignal* netsignal, mNetSignals) {
+      auto layerIt = mCachedPaths.constFind(layer);
+      if ((netsignal) && (!mModifiedNetSignals.contains(netsignal)) &&
+          (layerIt != mCachedPaths.constEnd()) &&
+          (layerIt->contains(netsignal))) {
+        cache[layer][netsignal] = layerIt->value(netsignal);
+      } else {
+        keys.append(qMakePair(layer, netsignal));
+      }
+    }
+  }
 
-  qreal             progressSpan = progressEnd - progressStart;
-  QList<NetSignal*> netsignals =
-      mBoard.getProject().getCircuit().getNetSignals().values();
-  netsignals.append(nullptr);  // also check unconnected copper objects
+  QVector<ClipperLib::Paths> paths(keys.count());
+  ClipperLib::Paths*         pathSlots = paths.data();
+  QVector<WorkUnit>          units;
+  for (int i = 0; i < keys.count(); ++i) {
+    units.append(WorkUnit{tr("Prepare copper areas..."), 1,
+                          [this, &keys, pathSlots, i]() {
+                            BoardClipperPathGenerator gen(mBoard,
+                                                          maxArcTolerance());
+                            gen.addCopper(keys.at(i).first->getName(),
+                                          keys.at(i).second);
+                            pathSlots[i] = gen.getPaths();
+                            return Messages();
+                          }});
+  }
+  executeWorkUnits(units, progressStart, progressEnd);  // can throw
+
+  bool unconnectedCopperModified = false;
+  for (int i = 0; i < keys.count(); ++i) {
+    const GraphicsLayer* layer     = keys.at(i).first;
+    const NetSignal*     netsignal = keys.at(i).second;
+    if ((!netsignal) &&
+        (mCachedPaths.value(layer).value(netsignal) != paths.at(i))) {
+      unconnectedCopperModified = true;
+    }
+    cache[layer][netsignal] = paths.at(i);
+  }
+  if (unconnectedCopperModified) {
+    mModifiedNetSignals.insert(nullptr);
+  }
+  mCachedPaths = cache;
+}
 
+void BoardDesignRuleCheck::updateBoardOutlineRestrictedArea() {
   // Board outline
   ClipperLib::Paths outlineRestrictedArea;
   {
@@ -155,130 +387,214 @@ void BoardDesignRuleCheck::checkCopperBoardClearances(int progressStart,
     ClipperHelpers::unite(outlineRestrictedArea, gen.getPaths());
   }
 
-  auto layers = mBoard.getLayerStack().getAllLayers();
-  for (int layerIndex = 0; layerIndex < layers.count(); ++layerIndex) {
-    const GraphicsLayer* layer = layers[layerIndex];
-    if ((!layer->isCopperLayer()) || (!layer->isEnabled())) {
-      continue;
-    }
-    for (int i = 0; i < netsignals.count(); ++i) {
+  mBoardOutlineModified =
+      (outlineRestrictedArea != mCachedOutlineRestrictedArea);
+  mCachedOutlineRestrictedArea = outlineRestrictedArea;
+}
+
+BoardDesignRuleCheck::Messages
+BoardDesignRuleCheck::checkForMissingConnections() const {
+  Messages messages;
+  foreach (const BI_AirWire* airwire, mBoard.getAirWires()) {
+    QString msg =
+        QString(tr("Missing connection: '%1'", "Placeholder is net name"))
+            .arg(*airwire->getNetSignal().getName());
+    Path location = Path::obround(airwire->getP1(), airwire->getP2(),
+                                  PositiveLength(50000));
+    messages.append(BoardDesignRuleCheckMessage(msg, location));
+  }
+  return messages;
+}
+
+BoardDesignRuleCheck::Messages BoardDesignRuleCheck::checkCopperBoardClearances(
+    const GraphicsLayer& layer, CopperLayerCache& cache) const {
+  Messages                                   messages;
+  QHash<const NetSignal*, ClipperLib::Paths> violations;
+  foreach (const NetSignal* netsignal, mNetSignals) {
+    ClipperLib::Paths paths;
+    if ((!mBoardOutlineModified) &&
+        (!mModifiedNetSignals.contains(netsignal)) &&
+        (cache.boardClearanceViolations.contains(netsignal))) {
+      paths = cache.boardClearanceViolations.value(netsignal);
+    } else {
       std::unique_ptr<ClipperLib::PolyTree> intersections =
-          ClipperHelpers::intersect(outlineRestrictedArea,
-                                    getCopperPaths(layer, netsignals[i]));
-      for (const ClipperLib::Path& path :
-           ClipperHelpers::flattenTree(*intersections)) {
-        QString name1 = netsignals[i] ? *netsignals[i]->getName() : "";
-        QString msg   = QString(tr("Clearance (%1): '%2' <-> Board Outline",
-                                 "Placeholders are layer name + net name"))
-                          .arg(layer->getNameTr(), name1);
-        Path location = ClipperHelpers::convert(path);
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
-      }
-      qreal progress = progressSpan *
-                       qreal((layerIndex + 1) * netsignals.count() + i + 1) /
-                       qreal(layers.count() * netsignals.count());
-      emit progressPercent(progressStart + static_cast<int>(progress));
+          ClipperHelpers::intersect(mCachedOutlineRestrictedArea,
+                                    getCopperPaths(&layer, netsignal));
+      paths = ClipperHelpers::flattenTree(*intersections);
+    }
+    violations.insert(netsignal, paths);
+    for (const ClipperLib::Path& path : paths) {
+      QString name1 = netsignal ? *netsignal->getName() : "";
+      QString msg   = QString(tr("Clearance (%1): '%2' <-> Board Outline",
+                               "Placeholders are layer name + net name"))
+                        .arg(layer.getNameTr(), name1);
+      Path location = ClipperHelpers::convert(path);
+      messages.append(BoardDesignRuleCheckMessage(msg, location));
     }
   }
+  cache.boardClearanceViolations = violations;
+  return messages;
 }
 
-void BoardDesignRuleCheck::checkCopperCopperClearances(int progressStart,
-                                                       int progressEnd) {
-  emit progressStatus(tr("Check copper clearances..."));
-
-  qreal             progressSpan = progressEnd - progressStart;
-  QList<NetSignal*> netsignals =
-      mBoard.getProject().getCircuit().getNetSignals().values();
-  netsignals.append(nullptr);  // also check unconnected copper objects
-
-  auto layers = mBoard.getLayerStack().getAllLayers();
-  for (int layerIndex = 0; layerIndex < layers.count(); ++layerIndex) {
-    const GraphicsLayer* layer = layers[layerIndex];
-    if ((!layer->isCopperLayer()) || (!layer->isEnabled())) {
-      continue;
-    }
-    for (int i = 0; i < netsignals.count(); ++i) {
-      ClipperLib::Paths paths1 = getCopperPaths(layer, netsignals[i]);
+BoardDesignRuleCheck::Messages
+BoardDesignRuleCheck::checkCopperCopperClearances(
+    const GraphicsLayer& layer, CopperLayerCache& cache) const {
+  Messages messages;
+
+  // Offset the copper of each net only once and determine its bounding rect
+  QVector<ClipperLib::Paths>   paths(mNetSignals.count());
+  QVector<ClipperLib::IntRect> rects(mNetSignals.count());
+  QVector<bool>                modified(mNetSignals.count());
+  QVector<int>                 netsWithCopper;
+  for (int i = 0; i < mNetSignals.count(); ++i) {
+    const NetSignal* netsignal = mNetSignals[i];
+    modified[i] = mModifiedNetSignals.contains(netsignal) ||
+                  (!cache.clearanceAreas.contains(netsignal));
+    if (modified[i]) {
+      paths[i] = getCopperPaths(&layer, netsignal);
       ClipperHelpers::offset(
-          paths1, (*mOptions.minCopperCopperClearance - *maxArcTolerance()) / 2,
+          paths[i],
+          (*mOptions.minCopperCopperClearance - *maxArcTolerance()) / 2,
           maxArcTolerance());
-      for (int k = i + 1; k < netsignals.count(); ++k) {
-        ClipperLib::Paths paths2 = getCopperPaths(layer, netsignals[k]);
-        ClipperHelpers::offset(
-            paths2,
-            (*mOptions.minCopperCopperClearance - *maxArcTolerance()) / 2,
-            maxArcTolerance());
-        std::unique_ptr<ClipperLib::PolyTree> intersections =
-            ClipperHelpers::intersect(paths1, paths2);
-        for (const ClipperLib::Path& path :
-             ClipperHelpers::flattenTree(*intersections)) {
-          QString name1 = netsignals[i] ? *netsignals[i]->getName() : "";
-          QString name2 = netsignals[k] ? *netsignals[k]->getName() : "";
-          QString msg   = QString(tr("Clearance (%1): '%2' <-> '%3'",
-                                   "Placeholders are layer name + net names"))
-                            .arg(layer->getNameTr(), name1, name2);
-          Path location = ClipperHelpers::convert(path);
-          addMessage(BoardDesignRuleCheckMessage(msg, location));
-        }
+      rects[i] = ClipperHelpers::getBoundingRect(paths[i]);
+    } else {
+      paths[i] = cache.clearanceAreas.value(netsignal);
+      rects[i] = cache.clearanceRects.value(netsignal);
+    }
+    if (!paths[i].empty()) {
+      netsWithCopper.append(i);
+    }
+  }
+
+  // Broad phase: Determine all net pairs with overlapping bounding rects by
+  // sweeping over the nets sorted by their left edge. Only these pairs can
+  // have clearance violations, so all others don't need to be intersected.
+  std::sort(netsWithCopper.begin(), netsWithCopper.end(),
+            [&rects](int a, int b) { return rects[a].left < rects[b].left; });
+  QVector<QPair<int, int>> candidates;
+  for (int a = 0; a < netsWithCopper.count(); ++a) {
+    int i = netsWithCopper[a];
+    for (int b = a + 1; b < netsWithCopper.count(); ++b) {
+      int k = netsWithCopper[b];
+      if (rects[k].left > rects[i].right) {
+        break;  // all following nets are located further right
+      }
+      if (ClipperHelpers::intersects(rects[i], rects[k])) {
+        candidates.append(qMakePair(qMin(i, k), qMax(i, k)));
       }
-      qreal progress = progressSpan *
-                       qreal((layerIndex + 1) * netsignals.count() + i + 1) /
-                       qreal(layers.count() * netsignals.count());
-      emit progressPercent(progressStart + static_cast<int>(progress));
     }
   }
+  // Keep the same order of messages as without the broad phase
+  std::sort(candidates.begin(), candidates.end());
+
+  // Narrow phase: Intersect the copper of the remaining net pairs, or reuse
+  // the cached result if both nets were not modified
+  QHash<NetSignalPair, ClipperLib::Paths> violations;
+  foreach (const auto& candidate, candidates) {
+    int               i   = candidate.first;
+    int               k   = candidate.second;
+    NetSignalPair     key = qMakePair(mNetSignals[i], mNetSignals[k]);
+    ClipperLib::Paths intersectionPaths;
+    if ((!modified[i]) && (!modified[k]) &&
+        (cache.copperClearanceViolations.contains(key))) {
+      intersectionPaths = cache.copperClearanceViolations.value(key);
+    } else {
+      std::unique_ptr<ClipperLib::PolyTree> intersections =
+          ClipperHelpers::intersect(paths[i], paths[k]);
+      intersectionPaths = ClipperHelpers::flattenTree(*intersections);
+    }
+    violations.insert(key, intersectionPaths);
+    for (const ClipperLib::Path& path : intersectionPaths) {
+      QString name1 = mNetSignals[i] ? *mNetSignals[i]->getName() : "";
+      QString name2 = mNetSignals[k] ? *mNetSignals[k]->getName() : "";
+      QString msg   = QString(tr("Clearance (%1): '%2' <-> '%3'",
+                               "Placeholders are layer name + net names"))
+                        .arg(layer.getNameTr(), name1, name2);
+      Path location = ClipperHelpers::convert(path);
+      messages.append(BoardDesignRuleCheckMessage(msg, location));
+    }
+  }
+
+  // Update cache
+  cache.clearanceAreas.clear();
+  cache.clearanceRects.clear();
+  for (int i = 0; i < mNetSignals.count(); ++i) {
+    cache.clearanceAreas.insert(mNetSignals[i], paths[i]);
+    cache.clearanceRects.insert(mNetSignals[i], rects[i]);
+  }
+  cache.copperClearanceViolations = violations;
+  return messages;
 }
 
-void BoardDesignRuleCheck::checkCourtyardClearances(int progressStart,
-                                                    int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check courtyard clearances..."));
+BoardDesignRuleCheck::Messages BoardDesignRuleCheck::checkCourtyardClearances(
+    const GraphicsLayer& layer, CourtyardLayerCache& cache) const {
+  Messages messages;
 
-  auto layers = mBoard.getLayerStack().getLayers(
-      {GraphicsLayer::sTopCourtyard, GraphicsLayer::sBotCourtyard});
-  foreach (const GraphicsLayer* layer, layers) {
-    // determine device courtyard areas
-    QMap<const BI_Device*, ClipperLib::Paths> deviceCourtyards;
-    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-      ClipperLib::Paths paths = getDeviceCourtyardPaths(*device, layer);
+  // determine device courtyard areas
+  QMap<const BI_Device*, ClipperLib::Paths> deviceCourtyards;
+  QSet<const BI_Device*>                    modifiedDevices;
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    if ((!mModifiedDevices.contains(device)) &&
+        (cache.courtyards.contains(device))) {
+      deviceCourtyards.insert(device, cache.courtyards.value(device));
+    } else {
+      ClipperLib::Paths paths = getDeviceCourtyardPaths(*device, &layer);
       ClipperHelpers::offset(paths, mOptions.courtyardOffset,
                              maxArcTolerance());
       deviceCourtyards.insert(device, paths);
+      modifiedDevices.insert(device);
     }
+  }
 
-    // check clearances
-    for (int i = 0; i < deviceCourtyards.count(); ++i) {
-      const BI_Device* dev1 = deviceCourtyards.keys()[i];
-      Q_ASSERT(dev1);
-      const ClipperLib::Paths& paths1 = deviceCourtyards[dev1];
-      for (int k = i + 1; k < deviceCourtyards.count(); ++k) {
-        const BI_Device* dev2 = deviceCourtyards.keys()[k];
-        Q_ASSERT(dev2);
-        const ClipperLib::Paths&              paths2 = deviceCourtyards[dev2];
+  // check clearances
+  QHash<DevicePair, ClipperLib::Paths> violations;
+  QList<const BI_Device*>              devices = deviceCourtyards.keys();
+  for (int i = 0; i < devices.count(); ++i) {
+    const BI_Device* dev1 = devices[i];
+    Q_ASSERT(dev1);
+    const ClipperLib::Paths& paths1 = deviceCourtyards[dev1];
+    for (int k = i + 1; k < devices.count(); ++k) {
+      const BI_Device* dev2 = devices[k];
+      Q_ASSERT(dev2);
+      const ClipperLib::Paths& paths2 = deviceCourtyards[dev2];
+      DevicePair               key    = qMakePair(dev1, dev2);
+      ClipperLib::Paths        intersectionPaths;
+      if ((!modifiedDevices.contains(dev1)) &&
+          (!modifiedDevices.contains(dev2)) &&
+          (cache.violations.contains(key))) {
+        intersectionPaths = cache.violations.value(key);
+      } else {
         std::unique_ptr<ClipperLib::PolyTree> intersections =
             ClipperHelpers::intersect(paths1, paths2);
-        for (const ClipperLib::Path& path :
-             ClipperHelpers::flattenTree(*intersections)) {
-          QString name1 = *dev1->getComponentInstance().getName();
-          QString name2 = *dev2->getComponentInstance().getName();
-          QString msg =
-              QString(tr("Clearance (%1): '%2' <-> '%3'",
-                         "Placeholders are layer name + component names"))
-                  .arg(layer->getNameTr(), name1, name2);
-          Path location = ClipperHelpers::convert(path);
-          addMessage(BoardDesignRuleCheckMessage(msg, location));
-        }
+        intersectionPaths = ClipperHelpers::flattenTree(*intersections);
+      }
+      violations.insert(key, intersectionPaths);  // empty if no violation
+      for (const ClipperLib::Path& path : intersectionPaths) {
+        QString name1 = *dev1->getComponentInstance().getName();
+        QString name2 = *dev2->getComponentInstance().getName();
+        QString msg =
+            QString(tr("Clearance (%1): '%2' <-> '%3'",
+                       "Placeholders are layer name + component names"))
+                .arg(layer.getNameTr(), name1, name2);
+        Path location = ClipperHelpers::convert(path);
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
 
-  emit progressPercent(progressEnd);
+  // Update cache
+  cache.courtyards.clear();
+  for (auto it = deviceCourtyards.constBegin();
+       it != deviceCourtyards.constEnd(); ++it) {
+    cache.courtyards.insert(it.key(), it.value());
+  }
+  cache.violations = violations;
+  return messages;
 }
 
-void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressStart,
-                                                   int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check minimum copper width..."));
+BoardDesignRuleCheck::Messages
+BoardDesignRuleCheck::checkMinimumCopperWidth() const {
+  Messages messages;
 
   // stroke texts
   foreach (const BI_StrokeText* text, mBoard.getStrokeTexts()) {
@@ -300,7 +616,7 @@ void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressStart,
         locations += path.toOutlineStrokes(PositiveLength(
             qMax(*text->getText().getStrokeWidth(), Length(50000))));
       }
-      addMessage(BoardDesignRuleCheckMessage(msg, locations));
+      messages.append(BoardDesignRuleCheckMessage(msg, locations));
     }
   }
 
@@ -319,7 +635,7 @@ void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressStart,
       QVector<Path> locations =
           plane->getOutline().toClosedPath().toOutlineStrokes(
               PositiveLength(200000));
-      addMessage(BoardDesignRuleCheckMessage(msg, locations));
+      messages.append(BoardDesignRuleCheckMessage(msg, locations));
     }
   }
 
@@ -346,7 +662,7 @@ void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressStart,
           locations += path.toOutlineStrokes(PositiveLength(
               qMax(*text->getText().getStrokeWidth(), Length(50000))));
         }
-        addMessage(BoardDesignRuleCheckMessage(msg, locations));
+        messages.append(BoardDesignRuleCheckMessage(msg, locations));
       }
     }
   }
@@ -366,18 +682,17 @@ void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressStart,
         Path location = Path::obround(netline->getStartPoint().getPosition(),
                                       netline->getEndPoint().getPosition(),
                                       netline->getWidth());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
 
-  emit progressPercent(progressEnd);
+  return messages;
 }
 
-void BoardDesignRuleCheck::checkMinimumPthRestring(int progressStart,
-                                                   int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check minimum PTH restrings..."));
+BoardDesignRuleCheck::Messages
+BoardDesignRuleCheck::checkMinimumPthRestring() const {
+  Messages messages;
 
   // vias
   foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
@@ -392,7 +707,7 @@ void BoardDesignRuleCheck::checkMinimumPthRestring(int progressStart,
                                   mOptions.minPthRestring +
                                   mOptions.minPthRestring;
         Path location = Path::circle(diameter).translated(via->getPosition());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
@@ -417,18 +732,17 @@ void BoardDesignRuleCheck::checkMinimumPthRestring(int progressStart,
             PositiveLength(pad->getLibPad().getDrillDiameter() + 1) +
             mOptions.minPthRestring + mOptions.minPthRestring;
         Path location = Path::circle(diameter).translated(pad->getPosition());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
 
-  emit progressPercent(progressEnd);
+  return messages;
 }
 
-void BoardDesignRuleCheck::checkMinimumPthDrillDiameter(int progressStart,
-                                                        int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check minimum PTH drill diameters..."));
+BoardDesignRuleCheck::Messages
+BoardDesignRuleCheck::checkMinimumPthDrillDiameter() const {
+  Messages messages;
 
   // vias
   foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
@@ -440,7 +754,7 @@ void BoardDesignRuleCheck::checkMinimumPthDrillDiameter(int progressStart,
                                formatLength(*via->getDrillDiameter()));
         Path location = Path::circle(via->getDrillDiameter())
                             .translated(via->getPosition());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
@@ -462,18 +776,17 @@ void BoardDesignRuleCheck::checkMinimumPthDrillDiameter(int progressStart,
         PositiveLength diameter(
             qMax(*pad->getLibPad().getDrillDiameter(), Length(50000)));
         Path location = Path::circle(diameter).translated(pad->getPosition());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
 
-  emit progressPercent(progressEnd);
+  return messages;
 }
 
-void BoardDesignRuleCheck::checkMinimumNpthDrillDiameter(int progressStart,
-                                                         int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check minimum NPTH drill diameters..."));
+BoardDesignRuleCheck::Messages
+BoardDesignRuleCheck::checkMinimumNpthDrillDiameter() const {
+  Messages messages;
 
   QString msgTr = tr("Min. hole diameter: %1", "Placeholder is drill diameter");
 
@@ -483,7 +796,7 @@ void BoardDesignRuleCheck::checkMinimumNpthDrillDiameter(int progressStart,
       QString msg = msgTr.arg(formatLength(*hole->getHole().getDiameter()));
       Path    location = Path::circle(hole->getHole().getDiameter())
                           .translated(hole->getPosition());
-      addMessage(BoardDesignRuleCheckMessage(msg, location));
+      messages.append(BoardDesignRuleCheckMessage(msg, location));
     }
   }
 
@@ -496,26 +809,29 @@ void BoardDesignRuleCheck::checkMinimumNpthDrillDiameter(int progressStart,
         Path    location =
             Path::circle(hole.getDiameter())
                 .translated(footprint.mapToScene(hole.getPosition()));
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
   }
 
-  emit progressPercent(progressEnd);
+  return messages;
 }
 
 const ClipperLib::Paths& BoardDesignRuleCheck::getCopperPaths(
-    const GraphicsLayer* layer, const NetSignal* netsignal) {
-  if (!mCachedPaths[layer].contains(netsignal)) {
-    BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
-    gen.addCopper(layer->getName(), netsignal);
-    mCachedPaths[layer][netsignal] = gen.getPaths();
+    const GraphicsLayer* layer, const NetSignal* netsignal) const {
+  auto layerIt = mCachedPaths.constFind(layer);
+  if (layerIt != mCachedPaths.constEnd()) {
+    auto netIt = layerIt->constFind(netsignal);
+    if (netIt != layerIt->constEnd()) {
+      return *netIt;
+    }
   }
-  return mCachedPaths[layer][netsignal];
+  // The cache must have been built before, see buildCopperPathsCache()
+  throw LogicError(__FILE__, __LINE__);
 }
 
 ClipperLib::Paths BoardDesignRuleCheck::getDeviceCourtyardPaths(
-    const BI_Device& device, const GraphicsLayer* layer) {
+    const BI_Device& device, const GraphicsLayer* layer) const {
   ClipperLib::Paths paths;
   for (const Polygon& polygon : device.getLibFootprint().getPolygons()) {
     QString polygonLayer = *polygon.getLayerName();
@@ -551,12 +867,6 @@ ClipperLib::Paths BoardDesignRuleCheck::getDeviceCourtyardPaths(
   return paths;
 }
 
-void BoardDesignRuleCheck::addMessage(
-    const BoardDesignRuleCheckMessage& msg) noexcept {
-  mMessages.append(msg);
-  emit progressMessage(msg.getMessage());
-}
-
 QString BoardDesignRuleCheck::formatLength(const Length& length) const
     noexcept {
   return Toolbox::floatToString(length.toMm(), 6, QLocale()) % "mm";
@@ -29,6 +29,9 @@
 
 #include <QtCore>
 
+#include <functional>
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -40,6 +43,7 @@ namespace project {
 
 class Board;
 class BI_Device;
+class BI_Plane;
 class NetSignal;
 
 /*******************************************************************************
@@ -74,6 +78,20 @@ public:
         minPthDrillDiameter(250000),       // 250um
         courtyardOffset(0)                 // 0um
     {}
+
+    bool operator==(const Options& rhs) const noexcept {
+      return (minCopperWidth == rhs.minCopperWidth) &&
+             (minCopperCopperClearance == rhs.minCopperCopperClearance) &&
+             (minCopperBoardClearance == rhs.minCopperBoardClearance) &&
+             (minCopperNpthClearance == rhs.minCopperNpthClearance) &&
+             (minPthRestring == rhs.minPthRestring) &&
+             (minNpthDrillDiameter == rhs.minNpthDrillDiameter) &&
+             (minPthDrillDiameter == rhs.minPthDrillDiameter) &&
+             (courtyardOffset == rhs.courtyardOffset);
+    }
+    bool operator!=(const Options& rhs) const noexcept {
+      return !(*this == rhs);
+    }
   };
 
   // Constructors / Destructor
@@ -82,10 +100,28 @@ public:
   ~BoardDesignRuleCheck() noexcept;
 
   // Getters
+  const Options& getOptions() const noexcept { return mOptions; }
+  bool           isIncremental() const noexcept { return mIncremental; }
   const QList<BoardDesignRuleCheckMessage>& getMessages() const noexcept {
     return mMessages;
   }
 
+  // Setters
+  void setOptions(const Options& options) noexcept;
+
+  /**
+   * @brief Enable or disable the incremental mode
+   *
+   * In incremental mode, intermediate results are kept after #execute() and
+   * the next call to #execute() recalculates only the results which are
+   * affected by modifications of the board since then (see
+   * ::librepcb::project::Board::takeModifications()). The generated messages
+   * are the same as without incremental mode. Disabled by default.
+   *
+   * @param incremental   Whether to enable the incremental mode or not.
+   */
+  void setIncremental(bool incremental) noexcept;
+
   // General Methods
   void execute();
 
@@ -96,22 +132,71 @@ signals:
   void progressMessage(const QString& msg);
   void finished();
 
+private:  // Types
+  typedef QList<BoardDesignRuleCheckMessage>        Messages;
+  typedef QPair<const NetSignal*, const NetSignal*> NetSignalPair;
+  typedef QPair<const BI_Device*, const BI_Device*> DevicePair;
+
+  /**
+   * @brief An independent part of the whole check which can be executed in
+   *        a worker thread
+   *
+   * The function must only read from the board and shared data, it must not
+   * modify anything except its own cache and must not emit any signals.
+   */
+  struct WorkUnit {
+    QString                   status;  ///< Progress status message
+    qreal                     weight;  ///< Relative effort for the progress
+    std::function<Messages()> function;
+  };
+
+  /**
+   * @brief Intermediate results of a copper layer, kept for incremental checks
+   *
+   * Violations are stored as paths (even if empty) for each checked net resp.
+   * net pair, the messages are created from them on every run.
+   */
+  struct CopperLayerCache {
+    QHash<const NetSignal*, ClipperLib::Paths>   clearanceAreas;
+    QHash<const NetSignal*, ClipperLib::IntRect> clearanceRects;
+    QHash<const NetSignal*, ClipperLib::Paths>   boardClearanceViolations;
+    QHash<NetSignalPair, ClipperLib::Paths>      copperClearanceViolations;
+  };
+
+  /**
+   * @brief Intermediate results of a courtyard layer, kept for incremental
+   *        checks
+   */
+  struct CourtyardLayerCache {
+    QHash<const BI_Device*, ClipperLib::Paths> courtyards;
+    QHash<DevicePair, ClipperLib::Paths>       violations;
+  };
+
 private:  // Methods
-  void rebuildPlanes(int progressStart, int progressEnd);
-  void checkForMissingConnections(int progressStart, int progressEnd);
-  void checkCopperBoardClearances(int progressStart, int progressEnd);
-  void checkCopperCopperClearances(int progressStart, int progressEnd);
-  void checkCourtyardClearances(int progressStart, int progressEnd);
-  void checkMinimumCopperWidth(int progressStart, int progressEnd);
-  void checkMinimumPthRestring(int progressStart, int progressEnd);
-  void checkMinimumPthDrillDiameter(int progressStart, int progressEnd);
-  void checkMinimumNpthDrillDiameter(int progressStart, int progressEnd);
+  QVector<Messages> executeWorkUnits(const QVector<WorkUnit>& units,
+                                     int progressStart, int progressEnd);
+  void              invalidateCache() noexcept;
+  void              determineModifications();
+  void              rebuildPlanes(int progressStart, int progressEnd);
+  void              rebuildAirWires(int progressStart, int progressEnd);
+  void              buildCopperPathsCache(int progressStart, int progressEnd);
+  void              updateBoardOutlineRestrictedArea();
+  Messages          checkForMissingConnections() const;
+  Messages checkCopperBoardClearances(const GraphicsLayer& layer,
+                                      CopperLayerCache&    cache) const;
+  Messages checkCopperCopperClearances(const GraphicsLayer& layer,
+                                       CopperLayerCache&    cache) const;
+  Messages checkCourtyardClearances(const GraphicsLayer& layer,
+                                    CourtyardLayerCache& cache) const;
+  Messages checkMinimumCopperWidth() const;
+  Messages checkMinimumPthRestring() const;
+  Messages checkMinimumPthDrillDiameter() const;
+  Messages checkMinimumNpthDrillDiameter() const;
   const ClipperLib::Paths& getCopperPaths(const GraphicsLayer* layer,
-                                          const NetSignal*     netsignal);
-  ClipperLib::Paths        getDeviceCourtyardPaths(const BI_Device&     device,
-                                                   const GraphicsLayer* layer);
-  void    addMessage(const BoardDesignRuleCheckMessage& msg) noexcept;
-  QString formatLength(const Length& length) const noexcept;
+                                          const NetSignal* netsignal) const;
+  ClipperLib::Paths getDeviceCourtyardPaths(const BI_Device&     device,
+                                            const GraphicsLayer* layer) const;
+  QString           formatLength(const Length& length) const noexcept;
 
   /**
    * Returns the maximum allowed arc tolerance when flattening arcs.
@@ -123,7 +208,29 @@ private:  // Methods
 private:  // Data
   Board&                             mBoard;
   Options                            mOptions;
+  bool                               mIncremental;
   QList<BoardDesignRuleCheckMessage> mMessages;
+  QList<NetSignal*>                  mNetSignals;    ///< Including nullptr
+  QList<const GraphicsLayer*>        mCopperLayers;  ///< Enabled ones only
+
+  // Modifications since the last run, only valid during #execute()
+  QSet<const NetSignal*> mModifiedNetSignals;
+  QSet<const BI_Device*> mModifiedDevices;
+  bool                   mBoardOutlineModified;
+
+  // Cached intermediate results, kept between runs in incremental mode
+  bool                                             mCacheValid;
+  QHash<const BI_Plane*, QVector<Path>>            mCachedPlaneFragments;
+  ClipperLib::Paths                                mCachedOutlineRestrictedArea;
+  QHash<const GraphicsLayer*, CopperLayerCache>    mCopperLayerCaches;
+  QHash<const GraphicsLayer*, CourtyardLayerCache> mCourtyardLayerCaches;
+
+  /**
+   * @brief Copper areas of all nets on all enabled copper layers
+   *
+   * Built by #buildCopperPathsCache() before any work unit is started,
+   * afterwards it is only read (from multiple threads).
+   */
   QHash<const GraphicsLayer*, QHash<const NetSignal*, ClipperLib::Paths>>
       mCachedPaths;
 };
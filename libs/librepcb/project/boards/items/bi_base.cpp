@@ -76,6 +76,7 @@ void BI_Base::addToBoard(QGraphicsItem* item) noexcept {
   Q_ASSERT(!mIsAddedToBoard);
   if (item) {
     mBoard.getGraphicsScene().addItem(*item);
+    mBoard.registerGraphicsItem(*item, *this);
   }
   mIsAddedToBoard = true;
 }
@@ -83,6 +84,7 @@ void BI_Base::addToBoard(QGraphicsItem* item) noexcept {
 void BI_Base::removeFromBoard(QGraphicsItem* item) noexcept {
   Q_ASSERT(mIsAddedToBoard);
   if (item) {
+    mBoard.unregisterGraphicsItem(*item);
     mBoard.getGraphicsScene().removeItem(*item);
   }
   mIsAddedToBoard = false;
@@ -236,6 +236,8 @@ void BI_FootprintPad::componentSignalInstanceNetSignalChanged(NetSignal* from,
   }
   mBoard.scheduleAirWiresRebuild(from);
   mBoard.scheduleAirWiresRebuild(to);
+  mBoard.markNetSignalModified(from);
+  mBoard.markNetSignalModified(to);
 }
 
 /*******************************************************************************
@@ -130,6 +130,7 @@ void BI_Plane::setOutline(const Path& outline) noexcept {
   if (outline != mOutline) {
     mOutline = outline;
     mGraphicsItem->updateCacheAndRepaint();
+    mBoard.markGeometryModified();
   }
 }
 
@@ -137,6 +138,7 @@ void BI_Plane::setLayerName(const GraphicsLayerName& layerName) noexcept {
   if (layerName != mLayerName) {
     mLayerName = layerName;
     mGraphicsItem->updateCacheAndRepaint();
+    mBoard.markGeometryModified();
   }
 }
 
@@ -158,30 +160,35 @@ void BI_Plane::setNetSignal(NetSignal& netsignal) {
 void BI_Plane::setMinWidth(const UnsignedLength& minWidth) noexcept {
   if (minWidth != mMinWidth) {
     mMinWidth = minWidth;
+    mBoard.markGeometryModified();
   }
 }
 
 void BI_Plane::setMinClearance(const UnsignedLength& minClearance) noexcept {
   if (minClearance != mMinClearance) {
     mMinClearance = minClearance;
+    mBoard.markGeometryModified();
   }
 }
 
 void BI_Plane::setConnectStyle(BI_Plane::ConnectStyle style) noexcept {
   if (style != mConnectStyle) {
     mConnectStyle = style;
+    mBoard.markGeometryModified();
   }
 }
 
 void BI_Plane::setPriority(int priority) noexcept {
   if (priority != mPriority) {
     mPriority = priority;
+    mBoard.markGeometryModified();
   }
 }
 
 void BI_Plane::setKeepOrphans(bool keepOrphans) noexcept {
   if (keepOrphans != mKeepOrphans) {
     mKeepOrphans = keepOrphans;
+    mBoard.markGeometryModified();
   }
 }
 
@@ -222,7 +229,11 @@ void BI_Plane::clear() noexcept {
 
 void BI_Plane::rebuild() noexcept {
   BoardPlaneFragmentsBuilder builder(*this);
-  mFragments = builder.buildFragments();
+  setFragments(builder.buildFragments());
+}
+
+void BI_Plane::setFragments(const QVector<Path>& fragments) noexcept {
+  mFragments = fragments;
   mGraphicsItem->updateCacheAndRepaint();
   mBoard.scheduleAirWiresRebuild(mNetSignal);
 }
@@ -26,6 +26,7 @@
 #include "bi_base.h"
 
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/geometry/polygon.h>
 #include <librepcb/common/graphics/graphicslayername.h>
 #include <librepcb/common/uuid.h>
 
@@ -37,7 +38,6 @@
 namespace librepcb {
 
 class Path;
-class Polygon;
 class PolygonGraphicsItem;
 
 namespace project {
@@ -101,10 +101,14 @@ private slots:
 
 private:
   void init();
+  void polygonEdited(const Polygon& polygon, Polygon::Event event) noexcept;
 
   // General
   QScopedPointer<Polygon>             mPolygon;
   QScopedPointer<PolygonGraphicsItem> mGraphicsItem;
+
+  // Slots
+  Polygon::OnEditedSlot mOnPolygonEditedSlot;
 };
 
 /*******************************************************************************
@@ -182,6 +182,9 @@ void BI_StrokeText::boardAttributesChanged() {
 void BI_StrokeText::strokeTextEdited(const StrokeText& text,
                                      StrokeText::Event event) noexcept {
   Q_UNUSED(text);
+  if (event != StrokeText::Event::PathsChanged) {
+    mBoard.markUnsaved();  // all properties except the paths are saved
+  }
   switch (event) {
     case StrokeText::Event::LayerNameChanged:
     case StrokeText::Event::PositionChanged:
@@ -54,8 +54,9 @@ Circuit::Circuit(Project& project, bool create)
       NetClass* netclass = new NetClass(*this, ElementName("default"));
       addNetClass(*netclass);  // add a netclass with name "default"
     } else {
-      SExpression root = SExpression::parse(
-          mDirectory->read("circuit.lp"), mDirectory->getAbsPath("circuit.lp"));
+      SExpression root =
+          SExpression::parse(mDirectory->readView("circuit.lp").getContent(),
+                             mDirectory->getAbsPath("circuit.lp"));
 
       // OK - file is open --> now load the whole circuit stuff
 
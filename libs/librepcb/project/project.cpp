@@ -36,10 +36,13 @@
 #include <librepcb/common/fileio/directorylock.h>
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/fileio/sexpressioncache.h>
 #include <librepcb/common/fileio/versionfile.h>
 #include <librepcb/common/font/strokefontpool.h>
+#include <librepcb/common/scopeguard.h>
 
 #include <QPrinter>
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -48,6 +51,57 @@
 namespace librepcb {
 namespace project {
 
+/*******************************************************************************
+ *  Types
+ ******************************************************************************/
+
+struct ParsedProjectFile {
+  FilePath                   filePath;
+  SExpression                root;
+  std::shared_ptr<Exception> error;  ///< Exceptions can't cross threads
+};
+
+/*******************************************************************************
+ *  Static Helpers
+ ******************************************************************************/
+
+/**
+ * @brief Read and parse each file listed in an index file in a worker thread
+ *
+ * @param dir         The project directory
+ * @param cache       Cache of already parsed files
+ * @param indexFile   Path of the index file (e.g. "boards/boards.lp")
+ * @param tagName     Name of the index file entries (e.g. "board")
+ *
+ * @return The results, in the same order as in the index file
+ *
+ * @throw Exception   If the index file could not be read
+ */
+static QList<QFuture<ParsedProjectFile>> startParsingFiles(
+    const TransactionalDirectory& dir, SExpressionCache& cache,
+    const QString& indexFile, const QString& tagName) {
+  SExpression root =
+      SExpression::parse(dir.read(indexFile), dir.getAbsPath(indexFile));
+  QList<QFuture<ParsedProjectFile>> futures;
+  foreach (const SExpression& node, root.getChildren(tagName)) {
+    FilePath fp = FilePath::fromRelative(
+        dir.getAbsPath(), node.getValueOfFirstChild<QString>());  // can throw
+    futures.append(QtConcurrent::run([&dir, &cache, fp]() {
+      ParsedProjectFile file;
+      file.filePath   = fp;
+      QString relPath = fp.toRelative(dir.getAbsPath());
+      try {
+        FileView view = dir.readView(relPath);               // can throw
+        file.root     = cache.parse(view.getContent(), fp);  // can throw
+      } catch (const Exception& e) {
+        file.error.reset(e.clone());
+      }
+      return file;
+    }));
+  }
+  return futures;
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -67,6 +121,7 @@ Project::Project(std::unique_ptr<TransactionalDirectory> directory,
                        tr("The suffix of the project file must be \"lpp\"!"));
   }
 
+  bool isOlderFileFormat = false;
   if (create) {
     // Check if there isn't already a project in the selected directory
     if (mDirectory->fileExists(".librepcb-project") ||
@@ -104,6 +159,7 @@ Project::Project(std::unique_ptr<TransactionalDirectory> directory,
               .arg(version.toPrettyStr(3))
               .arg(getFilepath().toNative()));
     }
+    isOlderFileFormat = (version < qApp->getFileFormatVersion());
   }
 
   // OK - the project is locked (or read-only) and can be opened!
@@ -144,6 +200,32 @@ Project::Project(std::unique_ptr<TransactionalDirectory> directory,
       mProjectMetadata.reset(new ProjectMetadata(root));
     }
 
+    // Start reading and parsing all schematic and board files in worker
+    // threads, while the circuit is being loaded. The schematics and boards
+    // are still created one after another in this thread since they depend on
+    // the circuit and on each other. Make sure no worker accesses the
+    // directory or the cache anymore when leaving this scope (e.g. due to an
+    // exception). Unmodified files are restored from the cache instead of
+    // being parsed again.
+    SExpressionCache cache(
+        mDirectory->getAbsPath(".cache/sexpressions_v1.bin"));
+
+    QList<QFuture<ParsedProjectFile>> schematicFiles;
+    QList<QFuture<ParsedProjectFile>> boardFiles;
+
+    auto sg = scopeGuard([&]() {
+      foreach (QFuture<ParsedProjectFile> future, schematicFiles + boardFiles) {
+        future.waitForFinished();
+      }
+    });
+    if (!create) {
+      schematicFiles =
+          startParsingFiles(*mDirectory, cache, "schematics/schematics.lp",
+                            "schematic");  // can throw
+      boardFiles = startParsingFiles(*mDirectory, cache, "boards/boards.lp",
+                                     "board");  // can throw
+    }
+
     // Create all needed objects
     connect(mProjectMetadata.data(), &ProjectMetadata::attributesChanged, this,
             &Project::attributesChanged);
@@ -158,43 +240,62 @@ Project::Project(std::unique_ptr<TransactionalDirectory> directory,
     mSchematicLayerProvider.reset(new SchematicLayerProvider(*this));
 
     // Load all schematics
-    if (!create) {
-      QString     fp = "schematics/schematics.lp";
-      SExpression schRoot =
-          SExpression::parse(mDirectory->read(fp), mDirectory->getAbsPath(fp));
-      foreach (const SExpression& node, schRoot.getChildren("schematic")) {
-        FilePath fp = FilePath::fromRelative(
-            getPath(), node.getValueOfFirstChild<QString>());
-        std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
-            *mDirectory, fp.getParentDir().toRelative(getPath())));
-        Schematic* schematic = new Schematic(*this, std::move(dir));
-        addSchematic(*schematic);
+    foreach (QFuture<ParsedProjectFile> future, schematicFiles) {
+      const ParsedProjectFile& file = future.result();  // blocks
+      if (file.error) {
+        file.error->raise();
       }
+      std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
+          *mDirectory, file.filePath.getParentDir().toRelative(getPath())));
+      Schematic* schematic = new Schematic(*this, std::move(dir), file.root);
+      addSchematic(*schematic);
+    }
+    if (!create) {
       qDebug() << mSchematics.count() << "schematics successfully loaded!";
     }
 
     // Load all boards
-    if (!create) {
-      QString     fp = "boards/boards.lp";
-      SExpression brdRoot =
-          SExpression::parse(mDirectory->read(fp), mDirectory->getAbsPath(fp));
-      foreach (const SExpression& node, brdRoot.getChildren("board")) {
-        FilePath fp = FilePath::fromRelative(
-            getPath(), node.getValueOfFirstChild<QString>());
-        std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
-            *mDirectory, fp.getParentDir().toRelative(getPath())));
-        Board* board = new Board(*this, std::move(dir));
-        addBoard(*board);
+    foreach (QFuture<ParsedProjectFile> future, boardFiles) {
+      const ParsedProjectFile& file = future.result();  // blocks
+      if (file.error) {
+        file.error->raise();
       }
+      std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
+          *mDirectory, file.filePath.getParentDir().toRelative(getPath())));
+      Board* board = new Board(*this, std::move(dir), file.root);
+      addBoard(*board);
+    }
+    if (!create) {
       qDebug() << mBoards.count() << "boards successfully loaded!";
     }
 
+    // Only modified schematics and boards are saved, so make sure that files
+    // of an older file format get upgraded on the next save.
+    if (isOlderFileFormat) {
+      foreach (Schematic* schematic, mSchematics) {
+        schematic->markUnsaved();
+      }
+      foreach (Board* board, mBoards) {
+        board->markUnsaved();
+      }
+    }
+
     // at this point, the whole circuit with all schematics and boards is
     // successfully loaded, so the ERC list now contains all the correct ERC
     // messages. So we can now restore the ignore state of each ERC message from
     // the file.
     mErcMsgList->restoreIgnoreState();  // can throw
 
+    // Update the cache to speed up opening the project the next time. This is
+    // not critical, so errors are ignored.
+    if ((!create) && mDirectory->isWritable()) {
+      try {
+        cache.save();  // can throw
+      } catch (const Exception& e) {
+        qWarning() << "Could not update the project cache:" << e.getMsg();
+      }
+    }
+
     if (create) save();  // write all files to file system
   } catch (...) {
     // free the allocated memory in the reverse order of their allocation...
@@ -497,9 +598,19 @@ void Project::removeBoard(Board& board, bool deleteBoard) {
  *  General Methods
  ******************************************************************************/
 
-void Project::save() {
+void Project::save(bool force) {
   qDebug() << "Save project files to transactional file system...";
 
+  // Mark all schematics and boards as modified to serialize them all
+  if (force) {
+    foreach (Schematic* schematic, mSchematics) {
+      schematic->markUnsaved();
+    }
+    foreach (Board* board, mBoards) {
+      board->markUnsaved();
+    }
+  }
+
   // Save version file
   mDirectory->write(
       ".librepcb-project",
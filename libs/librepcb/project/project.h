@@ -382,9 +382,17 @@ public:
   /**
    * @brief Save the project to the transactional file system
    *
+   * Schematics and boards are only serialized if they were modified since the
+   * last call (see ::librepcb::project::Board::hasUnsavedChanges()), and files
+   * with unchanged content are not marked as modified in the file system.
+   *
+   * @param force   If true, all schematics and boards are serialized, even if
+   *                they were not modified. This is needed to rewrite files
+   *                which are not canonical (e.g. modified by a text editor).
+   *
    * @throw Exception     If an error occurred.
    */
-  void save();
+  void save(bool force = false);
 
   // Inherited from AttributeProvider
   /// @copydoc librepcb::AttributeProvider::getUserDefinedAttributeValue()
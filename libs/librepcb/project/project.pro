@@ -10,7 +10,7 @@ TARGET = librepcbproject
 # Use common project definitions
 include(../../../common.pri)
 
-QT += core widgets xml sql printsupport
+QT += core widgets xml sql printsupport concurrent
 
 CONFIG += staticlib
 
@@ -25,11 +25,14 @@ RESOURCES += \
 SOURCES += \
     boards/board.cpp \
     boards/boardairwiresbuilder.cpp \
+    boards/boardairwiresrebuilder.cpp \
     boards/boardfabricationoutputsettings.cpp \
     boards/boardgerberexport.cpp \
     boards/boardlayerstack.cpp \
     boards/boardpickplacegenerator.cpp \
     boards/boardplanefragmentsbuilder.cpp \
+    boards/boardplaneobstaclecache.cpp \
+    boards/boardplanesrebuilder.cpp \
     boards/boardselectionquery.cpp \
     boards/boardusersettings.cpp \
     boards/cmd/cmdboardadd.cpp \
@@ -146,11 +149,14 @@ SOURCES += \
 HEADERS += \
     boards/board.h \
     boards/boardairwiresbuilder.h \
+    boards/boardairwiresrebuilder.h \
     boards/boardfabricationoutputsettings.h \
     boards/boardgerberexport.h \
     boards/boardlayerstack.h \
     boards/boardpickplacegenerator.h \
     boards/boardplanefragmentsbuilder.h \
+    boards/boardplaneobstaclecache.h \
+    boards/boardplanesrebuilder.h \
     boards/boardselectionquery.h \
     boards/boardusersettings.h \
     boards/cmd/cmdboardadd.h \
@@ -65,10 +65,12 @@ bool CmdSchematicNetLabelAdd::performExecute() {
 
 void CmdSchematicNetLabelAdd::performUndo() {
   mNetSegment.removeNetLabel(*mNetLabel);  // can throw
+  mNetSegment.getSchematic().markUnsaved();
 }
 
 void CmdSchematicNetLabelAdd::performRedo() {
   mNetSegment.addNetLabel(*mNetLabel);  // can throw
+  mNetSegment.getSchematic().markUnsaved();
 }
 
 /*******************************************************************************
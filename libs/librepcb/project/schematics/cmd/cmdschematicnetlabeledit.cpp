@@ -23,6 +23,7 @@
 #include "cmdschematicnetlabeledit.h"
 
 #include "../items/si_netlabel.h"
+#include "../schematic.h"
 
 #include <QtCore>
 
@@ -103,11 +104,13 @@ bool CmdSchematicNetLabelEdit::performExecute() {
 void CmdSchematicNetLabelEdit::performUndo() {
   mNetLabel.setPosition(mOldPos);
   mNetLabel.setRotation(mOldRotation);
+  mNetLabel.getSchematic().markUnsaved();
 }
 
 void CmdSchematicNetLabelEdit::performRedo() {
   mNetLabel.setPosition(mNewPos);
   mNetLabel.setRotation(mNewRotation);
+  mNetLabel.getSchematic().markUnsaved();
 }
 
 /*******************************************************************************
@@ -60,10 +60,12 @@ bool CmdSchematicNetLabelRemove::performExecute() {
 
 void CmdSchematicNetLabelRemove::performUndo() {
   mNetSegment.addNetLabel(mNetLabel);  // can throw
+  mNetSegment.getSchematic().markUnsaved();
 }
 
 void CmdSchematicNetLabelRemove::performRedo() {
   mNetSegment.removeNetLabel(mNetLabel);  // can throw
+  mNetSegment.getSchematic().markUnsaved();
 }
 
 /*******************************************************************************
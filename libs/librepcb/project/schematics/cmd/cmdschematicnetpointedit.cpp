@@ -23,6 +23,7 @@
 #include "cmdschematicnetpointedit.h"
 
 #include "../items/si_netpoint.h"
+#include "../schematic.h"
 
 #include <QtCore>
 
@@ -79,10 +80,12 @@ bool CmdSchematicNetPointEdit::performExecute() {
 
 void CmdSchematicNetPointEdit::performUndo() {
   mNetPoint.setPosition(mOldPos);
+  mNetPoint.getSchematic().markUnsaved();
 }
 
 void CmdSchematicNetPointEdit::performRedo() {
   mNetPoint.setPosition(mNewPos);
+  mNetPoint.getSchematic().markUnsaved();
 }
 
 /*******************************************************************************
@@ -25,6 +25,7 @@
 #include "../items/si_netline.h"
 #include "../items/si_netpoint.h"
 #include "../items/si_netsegment.h"
+#include "../schematic.h"
 
 #include <QtCore>
 
@@ -87,10 +88,12 @@ bool CmdSchematicNetSegmentAddElements::performExecute() {
 
 void CmdSchematicNetSegmentAddElements::performUndo() {
   mNetSegment.removeNetPointsAndNetLines(mNetPoints, mNetLines);  // can throw
+  mNetSegment.getSchematic().markUnsaved();
 }
 
 void CmdSchematicNetSegmentAddElements::performRedo() {
   mNetSegment.addNetPointsAndNetLines(mNetPoints, mNetLines);  // can throw
+  mNetSegment.getSchematic().markUnsaved();
 }
 
 /*******************************************************************************
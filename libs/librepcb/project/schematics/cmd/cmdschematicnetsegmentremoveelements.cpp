@@ -73,10 +73,12 @@ bool CmdSchematicNetSegmentRemoveElements::performExecute() {
 
 void CmdSchematicNetSegmentRemoveElements::performUndo() {
   mNetSegment.addNetPointsAndNetLines(mNetPoints, mNetLines);  // can throw
+  mNetSegment.getSchematic().markUnsaved();
 }
 
 void CmdSchematicNetSegmentRemoveElements::performRedo() {
   mNetSegment.removeNetPointsAndNetLines(mNetPoints, mNetLines);  // can throw
+  mNetSegment.getSchematic().markUnsaved();
 }
 
 /*******************************************************************************
@@ -23,6 +23,7 @@
 #include "cmdsymbolinstanceedit.h"
 
 #include "../items/si_symbol.h"
+#include "../schematic.h"
 
 #include <QtCore>
 
@@ -151,12 +152,14 @@ void CmdSymbolInstanceEdit::performUndo() {
   mSymbol.setPosition(mOldPos);
   mSymbol.setRotation(mOldRotation);
   mSymbol.setMirrored(mOldMirrored);
+  mSymbol.getSchematic().markUnsaved();
 }
 
 void CmdSymbolInstanceEdit::performRedo() {
   mSymbol.setPosition(mNewPos);
   mSymbol.setRotation(mNewRotation);
   mSymbol.setMirrored(mNewMirrored);
+  mSymbol.getSchematic().markUnsaved();
 }
 
 /*******************************************************************************
@@ -53,12 +53,14 @@ namespace project {
 
 Schematic::Schematic(Project&                                project,
                      std::unique_ptr<TransactionalDirectory> directory,
-                     bool create, const QString& newName)
+                     bool create, const QString& newName,
+                     const SExpression* parsedRoot)
   : QObject(&project),
     AttributeProvider(),
     mProject(project),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mHasUnsavedChanges(create),
     mUuid(Uuid::createRandom()),
     mName("New Page") {
   try {
@@ -72,8 +74,14 @@ Schematic::Schematic(Project&                                project,
       // load default grid properties
       mGridProperties.reset(new GridProperties());
     } else {
-      SExpression root = SExpression::parse(
-          mDirectory->read(getFilePath().getFilename()), getFilePath());
+      // the file might already have been parsed by the caller
+      SExpression ownRoot;
+      if (!parsedRoot) {
+        ownRoot = SExpression::parse(
+            mDirectory->readView(getFilePath().getFilename()).getContent(),
+            getFilePath());
+      }
+      const SExpression& root = parsedRoot ? *parsedRoot : ownRoot;
 
       // the schematic seems to be ready to open, so we will create all needed
       // objects
@@ -230,11 +238,13 @@ QList<SI_SymbolPin*> Schematic::getPinsAtScenePos(const Point& pos) const
  ******************************************************************************/
 
 void Schematic::setGridProperties(const GridProperties& grid) noexcept {
-  *mGridProperties = grid;
+  *mGridProperties   = grid;
+  mHasUnsavedChanges = true;
 }
 
 void Schematic::setName(const ElementName& name) noexcept {
-  mName = name;
+  mName              = name;
+  mHasUnsavedChanges = true;
   emit mProject.attributesChanged();
 }
 
@@ -264,6 +274,7 @@ void Schematic::addSymbol(SI_Symbol& symbol) {
   // add to schematic
   symbol.addToSchematic();  // can throw
   mSymbols.append(&symbol);
+  mHasUnsavedChanges = true;
 }
 
 void Schematic::removeSymbol(SI_Symbol& symbol) {
@@ -273,6 +284,7 @@ void Schematic::removeSymbol(SI_Symbol& symbol) {
   // remove from schematic
   symbol.removeFromSchematic();  // can throw
   mSymbols.removeOne(&symbol);
+  mHasUnsavedChanges = true;
 }
 
 /*******************************************************************************
@@ -301,6 +313,7 @@ void Schematic::addNetSegment(SI_NetSegment& netsegment) {
   // add to schematic
   netsegment.addToSchematic();  // can throw
   mNetSegments.append(&netsegment);
+  mHasUnsavedChanges = true;
 }
 
 void Schematic::removeNetSegment(SI_NetSegment& netsegment) {
@@ -310,6 +323,7 @@ void Schematic::removeNetSegment(SI_NetSegment& netsegment) {
   // remove from schematic
   netsegment.removeFromSchematic();  // can throw
   mNetSegments.removeOne(&netsegment);
+  mHasUnsavedChanges = true;
 }
 
 /*******************************************************************************
@@ -352,15 +366,22 @@ void Schematic::removeFromProject() {
   }
 
   mIsAddedToProject = false;
+  // The file will be removed on the next save, so it needs to be written again
+  // if the schematic gets added to the project again (e.g. by undo).
+  mHasUnsavedChanges = true;
   sgl.dismiss();
 }
 
 void Schematic::save() {
   if (mIsAddedToProject) {
-    // save schematic file
-    SExpression doc(serializeToDomElement("librepcb_schematic"));  // can throw
-    mDirectory->write(getFilePath().getFilename(),
-                      doc.toByteArray());  // can throw
+    // save schematic file, but only if it was modified since the last save
+    if (mHasUnsavedChanges) {
+      SExpression doc(
+          serializeToDomElement("librepcb_schematic"));  // can throw
+      mDirectory->write(getFilePath().getFilename(),
+                        doc.toByteArray());  // can throw
+      mHasUnsavedChanges = false;
+    }
   } else {
     mDirectory->removeDirRecursively();  // can throw
   }
@@ -457,7 +478,7 @@ void Schematic::serialize(SExpression& root) const {
 Schematic* Schematic::create(Project&                                project,
                              std::unique_ptr<TransactionalDirectory> directory,
                              const ElementName&                      name) {
-  return new Schematic(project, std::move(directory), true, *name);
+  return new Schematic(project, std::move(directory), true, *name, nullptr);
 }
 
 /*******************************************************************************
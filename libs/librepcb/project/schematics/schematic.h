@@ -113,7 +113,10 @@ public:
   Schematic()                       = delete;
   Schematic(const Schematic& other) = delete;
   Schematic(Project& project, std::unique_ptr<TransactionalDirectory> directory)
-    : Schematic(project, std::move(directory), false, QString()) {}
+    : Schematic(project, std::move(directory), false, QString(), nullptr) {}
+  Schematic(Project& project, std::unique_ptr<TransactionalDirectory> directory,
+            const SExpression& root)
+    : Schematic(project, std::move(directory), false, QString(), &root) {}
   ~Schematic() noexcept;
 
   // Getters: General
@@ -152,6 +155,10 @@ public:
   void           addNetSegment(SI_NetSegment& netsegment);
   void           removeNetSegment(SI_NetSegment& netsegment);
 
+  // Unsaved Changes Tracking (only modified schematics are written by #save())
+  void markUnsaved() noexcept { mHasUnsavedChanges = true; }
+  bool hasUnsavedChanges() const noexcept { return mHasUnsavedChanges; }
+
   // General Methods
   void addToProject();
   void removeFromProject();
@@ -191,7 +198,8 @@ signals:
 
 private:
   Schematic(Project& project, std::unique_ptr<TransactionalDirectory> directory,
-            bool create, const QString& newName);
+            bool create, const QString& newName,
+            const SExpression* parsedRoot);
   void updateIcon() noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
@@ -201,6 +209,7 @@ private:
   Project& mProject;  ///< A reference to the Project object (from the ctor)
   std::unique_ptr<TransactionalDirectory> mDirectory;
   bool                                    mIsAddedToProject;
+  bool                                    mHasUnsavedChanges;
 
   QScopedPointer<GraphicsScene>  mGraphicsScene;
   QScopedPointer<GridProperties> mGridProperties;
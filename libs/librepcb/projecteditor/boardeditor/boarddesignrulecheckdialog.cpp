@@ -24,7 +24,7 @@
 
 #include "ui_boarddesignrulecheckdialog.h"
 
-#include <librepcb/project/boards/board.h>
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/project/boards/drc/boarddesignrulecheck.h>
 
 #include <QtCore>
@@ -41,9 +41,8 @@ namespace editor {
  ******************************************************************************/
 
 BoardDesignRuleCheckDialog::BoardDesignRuleCheckDialog(
-    Board& board, const BoardDesignRuleCheck::Options& options,
-    QWidget* parent) noexcept
-  : QDialog(parent), mBoard(board), mUi(new Ui::BoardDesignRuleCheckDialog) {
+    BoardDesignRuleCheck& drc, QWidget* parent) noexcept
+  : QDialog(parent), mDrc(drc), mUi(new Ui::BoardDesignRuleCheckDialog) {
   mUi->setupUi(this);
   mUi->edtClearanceCopperCopper->setSingleStep(0.1);  // [mm]
   mUi->edtClearanceCopperBoard->setSingleStep(0.1);   // [mm]
@@ -57,6 +56,7 @@ BoardDesignRuleCheckDialog::BoardDesignRuleCheckDialog(
           &BoardDesignRuleCheckDialog::btnRunDrcClicked);
 
   // set options
+  const BoardDesignRuleCheck::Options& options = mDrc.getOptions();
   mUi->edtClearanceCopperCopper->setValue(options.minCopperCopperClearance);
   mUi->edtClearanceCopperBoard->setValue(options.minCopperBoardClearance);
   mUi->edtClearanceCopperNpth->setValue(options.minCopperNpthClearance);
@@ -101,25 +101,27 @@ void BoardDesignRuleCheckDialog::btnRunDrcClicked() noexcept {
     mUi->lstMessages->clear();
     mUi->lstProgress->clear();
 
-    BoardDesignRuleCheck drc(mBoard, getOptions());
-    connect(&drc, &BoardDesignRuleCheck::progressPercent, mUi->prgProgress,
+    // The DRC is kept alive between runs, so disconnect it afterwards
+    auto sg = scopeGuard([this]() { mDrc.disconnect(); });
+    mDrc.setOptions(getOptions());
+    connect(&mDrc, &BoardDesignRuleCheck::progressPercent, mUi->prgProgress,
             &QProgressBar::setValue);
-    connect(&drc, &BoardDesignRuleCheck::progressStatus, mUi->lstProgress,
+    connect(&mDrc, &BoardDesignRuleCheck::progressStatus, mUi->lstProgress,
             static_cast<void (QListWidget::*)(const QString&)>(
                 &QListWidget::addItem));
-    connect(&drc, &BoardDesignRuleCheck::progressMessage, mUi->lstMessages,
+    connect(&mDrc, &BoardDesignRuleCheck::progressMessage, mUi->lstMessages,
             static_cast<void (QListWidget::*)(const QString&)>(
                 &QListWidget::addItem));
 
     // Use the progressStatus() signal (because it is not emitted too often
     // which would lead to flickering) to update both list widgets.
-    connect(&drc, SIGNAL(progressStatus(QString)), mUi->lstProgress,
+    connect(&mDrc, SIGNAL(progressStatus(QString)), mUi->lstProgress,
             SLOT(repaint()));
-    connect(&drc, SIGNAL(progressStatus(QString)), mUi->lstMessages,
+    connect(&mDrc, SIGNAL(progressStatus(QString)), mUi->lstMessages,
             SLOT(repaint()));
 
-    drc.execute();  // can throw
-    mMessages = drc.getMessages();
+    mDrc.execute();  // can throw
+    mMessages = mDrc.getMessages();
   } catch (Exception& e) {
     QMessageBox::warning(this, tr("Error"), e.getMsg());
   }
@@ -35,8 +35,6 @@
 namespace librepcb {
 namespace project {
 
-class Board;
-
 namespace editor {
 
 namespace Ui {
@@ -57,9 +55,8 @@ public:
   // Constructors / Destructor
   BoardDesignRuleCheckDialog()                                        = delete;
   BoardDesignRuleCheckDialog(const BoardDesignRuleCheckDialog& other) = delete;
-  explicit BoardDesignRuleCheckDialog(
-      Board& board, const BoardDesignRuleCheck::Options& options,
-      QWidget* parent = 0) noexcept;
+  explicit BoardDesignRuleCheckDialog(BoardDesignRuleCheck& drc,
+                                      QWidget* parent = 0) noexcept;
   ~BoardDesignRuleCheckDialog();
 
   // Getters
@@ -73,7 +70,7 @@ private:  // GUI Event Handlers
   void btnRunDrcClicked() noexcept;
 
 private:
-  Board&                                           mBoard;
+  BoardDesignRuleCheck&                            mDrc;
   QScopedPointer<Ui::BoardDesignRuleCheckDialog>   mUi;
   tl::optional<QList<BoardDesignRuleCheckMessage>> mMessages;
 };
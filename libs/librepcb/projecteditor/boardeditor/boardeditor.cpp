@@ -320,7 +320,7 @@ void BoardEditor::setActiveBoardIndex(int index) noexcept {
       // stop airwire rebuild on every project modification (for performance
       // reasons)
       disconnect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified,
-                 mActiveBoard.data(), &Board::triggerAirWiresRebuild);
+                 mActiveBoard.data(), &Board::triggerAirWiresRebuildAsync);
       // save current view scene rect
       mActiveBoard->saveViewSceneRect(mGraphicsView->getVisibleSceneRect());
     }
@@ -330,10 +330,10 @@ void BoardEditor::setActiveBoardIndex(int index) noexcept {
       mActiveBoard->showInView(*mGraphicsView);
       mGraphicsView->setVisibleSceneRect(mActiveBoard->restoreViewSceneRect());
       mGraphicsView->setGridProperties(mActiveBoard->getGridProperties());
-      // force airwire rebuild immediately and on every project modification
-      mActiveBoard->triggerAirWiresRebuild();
+      // rebuild airwires now and on every project modification
+      mActiveBoard->triggerAirWiresRebuildAsync();
       connect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified,
-              mActiveBoard.data(), &Board::triggerAirWiresRebuild);
+              mActiveBoard.data(), &Board::triggerAirWiresRebuildAsync);
     } else {
       mGraphicsView->setScene(nullptr);
     }
@@ -497,7 +497,8 @@ void BoardEditor::on_actionPrint_triggered() {
     printDialog.setOption(QAbstractPrintDialog::PrintSelection, false);
     printDialog.setMinMax(1, 1);
     if (printDialog.exec() == QDialog::Accepted) {
-      board->print(printer);  // can throw
+      board->waitForPlanesRebuilt();  // don't print outdated planes
+      board->print(printer);          // can throw
     }
   } catch (Exception& e) {
     QMessageBox::warning(this, tr("Error"), e.getMsg());
@@ -540,7 +541,8 @@ void BoardEditor::on_actionExportAsPdf_triggered() {
       printer.setCreator(
           QString("LibrePCB %1").arg(qApp->applicationVersion()));
       printer.setOutputFileName(filepath.toStr());
-      board->print(printer);  // can throw
+      board->waitForPlanesRebuilt();  // don't export outdated planes
+      board->print(printer);          // can throw
     }
 
     QDesktopServices::openUrl(QUrl::fromLocalFile(filepath.toStr()));
@@ -669,7 +671,15 @@ void BoardEditor::on_actionDesignRuleCheck_triggered() {
   Board* board = getActiveBoard();
   if (!board) return;
 
-  BoardDesignRuleCheckDialog dialog(*board, mDrcOptions, this);
+  // Keep the DRC of each board alive to only check modified items next time
+  QPointer<BoardDesignRuleCheck>& drc = mDrcs[board->getUuid()];
+  if (!drc) {
+    drc = new BoardDesignRuleCheck(*board, mDrcOptions, board);
+    drc->setIncremental(true);
+  }
+  drc->setOptions(mDrcOptions);
+
+  BoardDesignRuleCheckDialog dialog(*drc, this);
   dialog.exec();
   mDrcOptions = dialog.getOptions();
   if (dialog.getMessages()) {
@@ -686,7 +696,7 @@ void BoardEditor::on_actionDesignRuleCheck_triggered() {
 void BoardEditor::on_actionRebuildPlanes_triggered() {
   Board* board = getActiveBoard();
   if (board) {
-    board->rebuildAllPlanes();
+    board->rebuildAllPlanesAsync();
     board->forceAirWiresRebuild();
   }
 }
@@ -145,7 +145,8 @@ private:
   QScopedPointer<ExclusiveActionGroup> mToolsActionGroup;
 
   // DRC
-  BoardDesignRuleCheck::Options mDrcOptions;
+  BoardDesignRuleCheck::Options               mDrcOptions;
+  QHash<Uuid, QPointer<BoardDesignRuleCheck>> mDrcs;  ///< Key: Board UUID
   QHash<Uuid, QList<BoardDesignRuleCheckMessage>>
                                     mDrcMessages;  ///< Key: Board UUID
   QScopedPointer<QGraphicsPathItem> mDrcLocationGraphicsItem;
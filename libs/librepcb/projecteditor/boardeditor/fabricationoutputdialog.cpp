@@ -168,9 +168,11 @@ void FabricationOutputDialog::on_btnGenerate_clicked() {
     s.setEnableSolderPasteBot(mUi->cbxSolderPasteBot->isChecked());
     if (s != mBoard.getFabricationOutputSettings()) {
       mBoard.getFabricationOutputSettings() = s;  // TODO: use undo command
+      mBoard.markUnsaved();
     }
 
     // generate files
+    mBoard.waitForPlanesRebuilt();  // don't export outdated planes
     BoardGerberExport grbExport(mBoard, mBoard.getFabricationOutputSettings());
     grbExport.exportAllLayers();
   } catch (Exception& e) {
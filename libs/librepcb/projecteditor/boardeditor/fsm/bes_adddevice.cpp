@@ -156,7 +156,7 @@ BES_Base::ProcRetVal BES_AddDevice::processSceneEvent(
       // set temporary position of the current device
       Q_ASSERT(!mCurrentDeviceEditCmd.isNull());
       mCurrentDeviceEditCmd->setPosition(pos, true);
-      board->triggerAirWiresRebuild();
+      board->triggerAirWiresRebuildAsync();
       break;
     }
 
@@ -204,7 +204,7 @@ BES_Base::ProcRetVal BES_AddDevice::processSceneEvent(
             // rotate device
             mCurrentDeviceEditCmd->rotate(
                 Angle::deg90(), mCurrentDeviceToPlace->getPosition(), true);
-            board->triggerAirWiresRebuild();
+            board->triggerAirWiresRebuildAsync();
             return ForceStayInState;
           }
           break;
@@ -291,7 +291,7 @@ void BES_AddDevice::rotateDevice(const Angle& angle) noexcept {
   Q_ASSERT(!mCurrentDeviceEditCmd.isNull());
   mCurrentDeviceEditCmd->rotate(angle, mCurrentDeviceToPlace->getPosition(),
                                 true);
-  mCurrentDeviceToPlace->getBoard().triggerAirWiresRebuild();
+  mCurrentDeviceToPlace->getBoard().triggerAirWiresRebuildAsync();
 }
 
 void BES_AddDevice::mirrorDevice(Qt::Orientation orientation) noexcept {
@@ -301,7 +301,7 @@ void BES_AddDevice::mirrorDevice(Qt::Orientation orientation) noexcept {
   try {
     mCurrentDeviceEditCmd->mirror(mCurrentDeviceToPlace->getPosition(),
                                   orientation, true);  // can throw
-    mCurrentDeviceToPlace->getBoard().triggerAirWiresRebuild();
+    mCurrentDeviceToPlace->getBoard().triggerAirWiresRebuildAsync();
   } catch (Exception& e) {
     QMessageBox::critical(&mEditor, tr("Error"), e.getMsg());
   }
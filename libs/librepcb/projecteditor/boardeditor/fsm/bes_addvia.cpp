@@ -324,7 +324,7 @@ bool BES_AddVia::updateVia(Board& board, const Point& pos) noexcept {
   try {
     mViaEditCmd->setPosition(pos, true);
     mViaEditCmd->setShape(mCurrentViaShape, true);
-    board.triggerAirWiresRebuild();
+    board.triggerAirWiresRebuildAsync();
     return true;
   } catch (Exception& e) {
     QMessageBox::critical(&mEditor, tr("Error"), e.getMsg());
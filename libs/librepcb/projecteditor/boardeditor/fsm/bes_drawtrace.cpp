@@ -645,9 +645,10 @@ void BES_DrawTrace::updateNetpointPositions(const Point& cursorPos) noexcept {
       mFixedStartAnchor->getPosition(), cursorPos, mCurrentWireMode));
   mPositioningNetPoint2->setPosition(cursorPos);
 
-  // Force updating airwires immediately as they are important for creating
-  // traces.
-  mPositioningNetPoint2->getBoard().triggerAirWiresRebuild();
+  // Start rebuilding the airwires right away as they are important for
+  // creating traces. The rebuild runs in a background thread, so the airwires
+  // are updated shortly after (not within) this mouse move event.
+  mPositioningNetPoint2->getBoard().triggerAirWiresRebuildAsync();
 }
 
 void BES_DrawTrace::layerComboBoxIndexChanged(int index) noexcept {
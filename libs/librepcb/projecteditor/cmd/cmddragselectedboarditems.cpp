@@ -178,9 +178,9 @@ void CmdDragSelectedBoardItems::setCurrentPosition(const Point& pos) noexcept {
     }
     mDeltaPos = delta;
 
-    // Force updating airwires immediately as they are important while moving
-    // items.
-    mBoard.triggerAirWiresRebuild();
+    // Update airwires as soon as possible as they are important while moving
+    // items. They are built in the background to keep dragging smooth.
+    mBoard.triggerAirWiresRebuildAsync();
   }
 }
 
@@ -212,9 +212,9 @@ void CmdDragSelectedBoardItems::rotate(const Angle& angle,
   }
   mDeltaAngle += angle;
 
-  // Force updating airwires immediately as they are important while dragging
-  // items.
-  mBoard.triggerAirWiresRebuild();
+  // Update airwires as soon as possible as they are important while dragging
+  // items. They are built in the background to keep dragging smooth.
+  mBoard.triggerAirWiresRebuildAsync();
 }
 
 /*******************************************************************************
@@ -264,7 +264,9 @@ void AddComponentDialog::searchComponents(const QString& input) {
 
   // min. 2 chars to avoid freeze on entering first character due to huge result
   if (input.length() > 1) {
-    SearchResult result = searchComponentsAndDevices(input);
+    SearchResult result =
+        mWorkspace.getLibraryDb().searchComponentsAndDevices(
+            input, mProject.getSettings().getLocaleOrder());  // can throw
     QHashIterator<FilePath, SearchResultComponent> cmpIt(result);
     while (cmpIt.hasNext()) {
       cmpIt.next();
@@ -289,82 +291,6 @@ void AddComponentDialog::searchComponents(const QString& input) {
   mUi->treeComponents->sortByColumn(0, Qt::AscendingOrder);
 }
 
-AddComponentDialog::SearchResult AddComponentDialog::searchComponentsAndDevices(
-    const QString& input) {
-  SearchResult       result;
-  const QStringList& localeOrder = mProject.getSettings().getLocaleOrder();
-
-  // add matching devices and their corresponding components
-  QList<Uuid> devices =
-      mWorkspace.getLibraryDb().getElementsBySearchKeyword<library::Device>(
-          input);  // can throw
-  foreach (const Uuid& devUuid, devices) {
-    FilePath devFp =
-        mWorkspace.getLibraryDb().getLatestDevice(devUuid);  // can throw
-    if (!devFp.isValid()) continue;
-    Uuid cmpUuid = Uuid::createRandom();
-    Uuid pkgUuid = Uuid::createRandom();
-    mWorkspace.getLibraryDb().getDeviceMetadata(devFp, &pkgUuid,
-                                                &cmpUuid);  // can throw
-    FilePath cmpFp =
-        mWorkspace.getLibraryDb().getLatestComponent(cmpUuid);  // can throw
-    if (!cmpFp.isValid()) continue;
-    FilePath pkgFp =
-        mWorkspace.getLibraryDb().getLatestPackage(pkgUuid);  // can throw
-    SearchResultDevice& resDev = result[cmpFp].devices[devFp];
-    resDev.pkgFp               = pkgFp;
-    resDev.match               = true;
-  }
-
-  // add matching components and all their devices
-  QList<Uuid> components =
-      mWorkspace.getLibraryDb().getElementsBySearchKeyword<library::Component>(
-          input);  // can throw
-  foreach (const Uuid& cmpUuid, components) {
-    FilePath cmpFp =
-        mWorkspace.getLibraryDb().getLatestComponent(cmpUuid);  // can throw
-    if (!cmpFp.isValid()) continue;
-    QSet<Uuid> devices =
-        mWorkspace.getLibraryDb().getDevicesOfComponent(cmpUuid);  // can throw
-    SearchResultComponent& resCmp = result[cmpFp];
-    resCmp.match                  = true;
-    foreach (const Uuid& devUuid, devices) {
-      FilePath devFp =
-          mWorkspace.getLibraryDb().getLatestDevice(devUuid);  // can throw
-      if (!devFp.isValid()) continue;
-      if (resCmp.devices.contains(devFp)) continue;
-      Uuid pkgUuid = Uuid::createRandom();
-      mWorkspace.getLibraryDb().getDeviceMetadata(devFp, &pkgUuid,
-                                                  nullptr);  // can throw
-      FilePath pkgFp =
-          mWorkspace.getLibraryDb().getLatestPackage(pkgUuid);  // can throw
-      SearchResultDevice& resDev = resCmp.devices[devFp];
-      resDev.pkgFp               = pkgFp;
-    }
-  }
-
-  // get name of elements
-  QMutableHashIterator<FilePath, SearchResultComponent> resultIt(result);
-  while (resultIt.hasNext()) {
-    resultIt.next();
-    mWorkspace.getLibraryDb().getElementTranslations<library::Component>(
-        resultIt.key(), localeOrder, &resultIt.value().name);
-    QMutableHashIterator<FilePath, SearchResultDevice> devIt(
-        resultIt.value().devices);
-    while (devIt.hasNext()) {
-      devIt.next();
-      mWorkspace.getLibraryDb().getElementTranslations<library::Device>(
-          devIt.key(), localeOrder, &devIt.value().name);
-      if (devIt.value().pkgFp.isValid()) {
-        mWorkspace.getLibraryDb().getElementTranslations<library::Package>(
-            devIt.value().pkgFp, localeOrder, &devIt.value().pkgName);
-      }
-    }
-  }
-
-  return result;
-}
-
 void AddComponentDialog::setSelectedCategory(
     const tl::optional<Uuid>& categoryUuid) {
   setSelectedComponent(nullptr);
@@ -27,6 +27,7 @@
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/uuid.h>
 #include <librepcb/workspace/library/cat/categorytreemodel.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
 
 #include <QtCore>
 #include <QtWidgets>
@@ -75,19 +76,9 @@ class AddComponentDialog final : public QDialog {
   Q_OBJECT
 
   // Types
-  struct SearchResultDevice {
-    QString  name;
-    FilePath pkgFp;
-    QString  pkgName;
-    bool     match = false;
-  };
-
-  struct SearchResultComponent {
-    QString                             name;
-    QHash<FilePath, SearchResultDevice> devices;
-    bool                                match = false;
-  };
-
+  typedef workspace::WorkspaceLibraryDb::DeviceSearchResult SearchResultDevice;
+  typedef workspace::WorkspaceLibraryDb::ComponentSearchResult
+                                                 SearchResultComponent;
   typedef QHash<FilePath, SearchResultComponent> SearchResult;
 
 public:
@@ -114,7 +105,6 @@ private slots:
 private:
   // Private Methods
   void         searchComponents(const QString& input);
-  SearchResult searchComponentsAndDevices(const QString& input);
   void         setSelectedCategory(const tl::optional<Uuid>& categoryUuid);
   void         setSelectedComponent(const library::Component* cmp);
   void setSelectedSymbVar(const library::ComponentSymbolVariant* symbVar);
@@ -219,11 +219,20 @@ bool ProjectEditor::autosaveProject() noexcept {
   }
 
   try {
+    // Serializing the project must be done in the main thread since the
+    // project is not thread-safe, but writing the files to disk is done in a
+    // background thread to not block the user interface.
     qDebug() << "Autosave project...";
-    mProject.save();                                      // can throw
-    mProject.getDirectory().getFileSystem()->autosave();  // can throw
-    qDebug() << "Project successfully autosaved";
-    return true;
+    mProject.save();  // can throw
+    std::shared_ptr<TransactionalFileSystem> fs =
+        mProject.getDirectory().getFileSystem();
+    if (fs->startAutosave()) {  // can throw
+      qDebug() << "Project autosave started in background";
+      return true;
+    } else {
+      qDebug() << "Previous autosave still running, skipped this one";
+      return false;
+    }
   } catch (Exception& exc) {
     return false;
   }
@@ -171,7 +171,10 @@ public slots:
    *
    * @note The whole save procedere is described in @ref doc_project_save.
    *
-   * @return true on success, false on failure
+   * @note The files are written to disk in a background thread, see
+   *       ::librepcb::TransactionalFileSystem::startAutosave().
+   *
+   * @return true if the autosave was started, false on failure
    */
   bool autosaveProject() noexcept;
 
@@ -52,7 +52,7 @@ using namespace library;
  ******************************************************************************/
 
 WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws)
-  : QObject(nullptr), mWorkspace(ws) {
+  : QObject(nullptr), mWorkspace(ws), mFullTextSearch(false) {
   qDebug("Load workspace library database...");
 
   // open SQLite database
@@ -73,6 +73,14 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws)
     setDbVersion(sCurrentDbVersion);           // can throw
   }
 
+  // The full-text search index is optional since not every SQLite build
+  // provides FTS5. Without it, searching falls back to a (slow) LIKE query.
+  mFullTextSearch = hasFullTextSearchTables();
+  if (!mFullTextSearch) {
+    qWarning() << "Library database has no full-text search index, searching"
+               << "library elements will be slow.";
+  }
+
   // create library scanner object
   mLibraryScanner.reset(new WorkspaceLibraryScanner(mWorkspace, mFilePath));
   connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::scanStarted, this,
@@ -197,44 +205,159 @@ FilePath WorkspaceLibraryDb::getLatestDevice(const Uuid& uuid) const {
 
 template <>
 QList<Uuid> WorkspaceLibraryDb::getElementsBySearchKeyword<Library>(
-    const QString& keyword) const {
-  return getElementsBySearchKeyword("libraries", "lib_id", keyword);
+    const QString& keyword, int limit) const {
+  return getElementsBySearchKeyword("libraries", "lib_id", keyword, limit);
 }
 
 template <>
 QList<Uuid> WorkspaceLibraryDb::getElementsBySearchKeyword<ComponentCategory>(
-    const QString& keyword) const {
-  return getElementsBySearchKeyword("component_categories", "cat_id", keyword);
+    const QString& keyword, int limit) const {
+  return getElementsBySearchKeyword("component_categories", "cat_id", keyword,
+                                    limit);
 }
 
 template <>
 QList<Uuid> WorkspaceLibraryDb::getElementsBySearchKeyword<PackageCategory>(
-    const QString& keyword) const {
-  return getElementsBySearchKeyword("package_categories", "cat_id", keyword);
+    const QString& keyword, int limit) const {
+  return getElementsBySearchKeyword("package_categories", "cat_id", keyword,
+                                    limit);
 }
 
 template <>
 QList<Uuid> WorkspaceLibraryDb::getElementsBySearchKeyword<Symbol>(
-    const QString& keyword) const {
-  return getElementsBySearchKeyword("symbols", "symbol_id", keyword);
+    const QString& keyword, int limit) const {
+  return getElementsBySearchKeyword("symbols", "symbol_id", keyword, limit);
 }
 
 template <>
 QList<Uuid> WorkspaceLibraryDb::getElementsBySearchKeyword<Package>(
-    const QString& keyword) const {
-  return getElementsBySearchKeyword("packages", "package_id", keyword);
+    const QString& keyword, int limit) const {
+  return getElementsBySearchKeyword("packages", "package_id", keyword, limit);
 }
 
 template <>
 QList<Uuid> WorkspaceLibraryDb::getElementsBySearchKeyword<Component>(
-    const QString& keyword) const {
-  return getElementsBySearchKeyword("components", "component_id", keyword);
+    const QString& keyword, int limit) const {
+  return getElementsBySearchKeyword("components", "component_id", keyword,
+                                    limit);
 }
 
 template <>
 QList<Uuid> WorkspaceLibraryDb::getElementsBySearchKeyword<Device>(
-    const QString& keyword) const {
-  return getElementsBySearchKeyword("devices", "device_id", keyword);
+    const QString& keyword, int limit) const {
+  return getElementsBySearchKeyword("devices", "device_id", keyword, limit);
+}
+
+QHash<FilePath, WorkspaceLibraryDb::ComponentSearchResult>
+    WorkspaceLibraryDb::searchComponentsAndDevices(
+        const QString& keyword, const QStringList& localeOrder) const {
+  QHash<FilePath, ComponentSearchResult> result;
+  QString                                value = getSearchKeywordValue(keyword);
+  if (value.isEmpty()) {
+    return result;
+  }
+
+  // All devices which match, or whose component matches. Note that all
+  // versions of these devices are queried to determine the latest version.
+  // Each query gets its own set of placeholders (see getSearchKeywordFilter()).
+  QStringList placeholders;
+  auto        devMatches = [&]() -> QString {
+    return getSearchKeywordFilter("devices", "device_id", placeholders);
+  };
+  auto cmpMatches = [&]() -> QString {
+    return getSearchKeywordFilter("components", "component_id", placeholders);
+  };
+  auto devUuids = [&]() -> QString {
+    return "SELECT uuid FROM devices WHERE uuid IN (" % devMatches() %
+        ") OR component_uuid IN (" % cmpMatches() % ")";
+  };
+
+  // devices (with columns component_uuid, package_uuid, match)
+  QHash<QString, FilePath>     devices;
+  QHash<FilePath, QString>     devNames;
+  QHash<FilePath, QStringList> devData;
+  placeholders.clear();
+  QSqlQuery query = mDb->prepareQuery(
+      "SELECT devices.uuid, devices.version, devices.filepath, "
+      "devices_tr.locale, devices_tr.name, devices.component_uuid, "
+      "devices.package_uuid, devices.uuid IN (" %
+      devMatches() %
+      ") "
+      "FROM devices "
+      "LEFT JOIN devices_tr ON devices_tr.device_id = devices.id "
+      "WHERE devices.uuid IN (" %
+      devUuids() % ")");
+  bindSearchKeywordValue(query, placeholders, value);
+  getLatestSearchElements(query, localeOrder, devices, devNames,
+                          devData);  // can throw
+
+  // components (with column match)
+  QHash<QString, FilePath>     components;
+  QHash<FilePath, QString>     cmpNames;
+  QHash<FilePath, QStringList> cmpData;
+  placeholders.clear();
+  query = mDb->prepareQuery(
+      "SELECT components.uuid, components.version, components.filepath, "
+      "components_tr.locale, components_tr.name, components.uuid IN (" %
+      cmpMatches() %
+      ") "
+      "FROM components "
+      "LEFT JOIN components_tr "
+      "ON components_tr.component_id = components.id "
+      "WHERE components.uuid IN (" %
+      cmpMatches() %
+      ") "
+      "OR components.uuid IN (SELECT component_uuid FROM devices "
+      "WHERE uuid IN (" %
+      devMatches() % "))");
+  bindSearchKeywordValue(query, placeholders, value);
+  getLatestSearchElements(query, localeOrder, components, cmpNames,
+                          cmpData);  // can throw
+
+  // packages of all devices
+  QHash<QString, FilePath>     packages;
+  QHash<FilePath, QString>     pkgNames;
+  QHash<FilePath, QStringList> pkgData;
+  placeholders.clear();
+  query = mDb->prepareQuery(
+      "SELECT packages.uuid, packages.version, packages.filepath, "
+      "packages_tr.locale, packages_tr.name "
+      "FROM packages "
+      "LEFT JOIN packages_tr ON packages_tr.package_id = packages.id "
+      "WHERE packages.uuid IN (SELECT package_uuid FROM devices "
+      "WHERE uuid IN (" %
+      devUuids() % "))");
+  bindSearchKeywordValue(query, placeholders, value);
+  getLatestSearchElements(query, localeOrder, packages, pkgNames,
+                          pkgData);  // can throw
+
+  // add matching components
+  foreach (const FilePath& cmpFp, components) {
+    if (cmpData.value(cmpFp).value(0) == "1") {
+      ComponentSearchResult& resCmp = result[cmpFp];
+      resCmp.name                   = cmpNames.value(cmpFp);
+      resCmp.match                  = true;
+    }
+  }
+
+  // add matching devices and all devices of matching components
+  foreach (const FilePath& devFp, devices) {
+    const QStringList& values   = devData.value(devFp);
+    FilePath           cmpFp    = components.value(values.value(0));
+    bool               devMatch = (values.value(2) == "1");
+    bool               cmpMatch = (cmpData.value(cmpFp).value(0) == "1");
+    if ((!cmpFp.isValid()) || ((!devMatch) && (!cmpMatch))) {
+      continue;
+    }
+    ComponentSearchResult& resCmp = result[cmpFp];
+    resCmp.name                   = cmpNames.value(cmpFp);
+    DeviceSearchResult& resDev    = resCmp.devices[devFp];
+    resDev.name                   = devNames.value(devFp);
+    resDev.pkgFp                  = packages.value(values.value(1));
+    resDev.pkgName                = pkgNames.value(resDev.pkgFp);
+    resDev.match                  = devMatch;
+  }
+  return result;
 }
 
 /*******************************************************************************
@@ -519,6 +642,22 @@ void WorkspaceLibraryDb::startLibraryRescan() noexcept {
   mLibraryScanner->startScan();
 }
 
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+QString WorkspaceLibraryDb::buildFullTextSearchQuery(
+    const QString& keyword) noexcept {
+  // The words are quoted to avoid interpreting them as FTS5 operators,
+  // punctuation within a word (e.g. "SOT-23") is then handled by the tokenizer.
+  QStringList words;
+  foreach (QString word,
+           keyword.split(QRegularExpression("\\s+"), QString::SkipEmptyParts)) {
+    words.append("\"" % word.replace("\"", "\"\"") % "\"*");
+  }
+  return words.join(" ");
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -702,15 +841,25 @@ QSet<Uuid> WorkspaceLibraryDb::getElementsByCategory(
 }
 
 QList<Uuid> WorkspaceLibraryDb::getElementsBySearchKeyword(
-    const QString& tablename, const QString& idrowname,
-    const QString& keyword) const {
-  QSqlQuery query = mDb->prepareQuery(QString("SELECT %1.uuid FROM %1, %1_tr "
-                                              "ON %1.id=%1_tr.%2 "
-                                              "WHERE %1_tr.name LIKE :keyword "
-                                              "OR %1_tr.keywords LIKE :keyword "
-                                              "ORDER BY %1_tr.name ASC ")
-                                          .arg(tablename, idrowname));
-  query.bindValue(":keyword", "%" + keyword + "%");
+    const QString& tablename, const QString& idrowname, const QString& keyword,
+    int limit) const {
+  QString value = getSearchKeywordValue(keyword);
+  if (value.isEmpty()) {
+    return QList<Uuid>();
+  }
+
+  // With full-text search, an element matches once per locale, so group by
+  // element and use the best rank (see createFullTextSearchTables()).
+  QStringList placeholders;
+  QString     filter =
+      getSearchKeywordFilter(tablename, idrowname, placeholders);
+  QString     order  = mFullTextSearch
+                      ? QString(" GROUP BY %1.id ORDER BY MIN(%1_fts.rank) ASC")
+                      : QString(" ORDER BY %1_tr.name ASC");
+  QSqlQuery query = mDb->prepareQuery(filter % order.arg(tablename) %
+                                      " LIMIT :limit");
+  bindSearchKeywordValue(query, placeholders, value);
+  query.bindValue(":limit", limit);
   mDb->exec(query);
 
   QList<Uuid> elements;
@@ -721,6 +870,96 @@ QList<Uuid> WorkspaceLibraryDb::getElementsBySearchKeyword(
   return elements;
 }
 
+QString WorkspaceLibraryDb::getSearchKeywordFilter(
+    const QString& tablename, const QString& idrowname,
+    QStringList& placeholders) const noexcept {
+  // Every occurrence of the keyword gets its own placeholder since binding
+  // the same named placeholder multiple times is not supported by all drivers.
+  auto placeholder = [&placeholders]() {
+    placeholders.append(QString(":keyword%1").arg(placeholders.count()));
+    return placeholders.last();
+  };
+  if (mFullTextSearch) {
+    return QString(
+               "SELECT %1.uuid FROM %1_fts "
+               "INNER JOIN %1_tr ON %1_tr.id = %1_fts.rowid "
+               "INNER JOIN %1 ON %1.id = %1_tr.%2 "
+               "WHERE %1_fts MATCH %3")
+        .arg(tablename, idrowname, placeholder());
+  } else {
+    QString namePlaceholder     = placeholder();
+    QString keywordsPlaceholder = placeholder();
+    return QString(
+               "SELECT %1.uuid FROM %1, %1_tr "
+               "ON %1.id=%1_tr.%2 "
+               "WHERE %1_tr.name LIKE %3 "
+               "OR %1_tr.keywords LIKE %4")
+        .arg(tablename, idrowname, namePlaceholder, keywordsPlaceholder);
+  }
+}
+
+void WorkspaceLibraryDb::bindSearchKeywordValue(
+    QSqlQuery& query, const QStringList& placeholders,
+    const QString& value) noexcept {
+  foreach (const QString& placeholder, placeholders) {
+    query.bindValue(placeholder, value);
+  }
+}
+
+QString WorkspaceLibraryDb::getSearchKeywordValue(const QString& keyword) const
+    noexcept {
+  if (mFullTextSearch) {
+    return buildFullTextSearchQuery(keyword);
+  } else {
+    return "%" + keyword + "%";
+  }
+}
+
+void WorkspaceLibraryDb::getLatestSearchElements(
+    QSqlQuery& query, const QStringList& localeOrder,
+    QHash<QString, FilePath>& latest, QHash<FilePath, QString>& names,
+    QHash<FilePath, QStringList>& data) const {
+  // The query must return the columns uuid, version, filepath, locale and
+  // name (one row per translation), followed by any additional columns which
+  // are returned in "data".
+  mDb->exec(query);
+  QHash<QString, QMultiMap<Version, FilePath>> versions;
+  QHash<FilePath, QList<QPair<QString, QString>>> translations;
+  while (query.next()) {
+    FilePath filepath(FilePath::fromRelative(mWorkspace.getLibrariesPath(),
+                                             query.value(2).toString()));
+    if (!filepath.isValid()) {
+      throw LogicError(__FILE__, __LINE__);
+    }
+    if (!data.contains(filepath)) {
+      Version version =
+          Version::fromString(query.value(1).toString());  // can throw
+      versions[query.value(0).toString()].insert(version, filepath);
+      QStringList values;
+      for (int i = 5; i < query.record().count(); ++i) {
+        values.append(query.value(i).toString());
+      }
+      data.insert(filepath, values);
+    }
+    if (!query.value(4).isNull()) {
+      translations[filepath].append(
+          qMakePair(query.value(3).toString(), query.value(4).toString()));
+    }
+  }
+
+  // only the latest version of each element is relevant
+  foreach (const QString& uuid, versions.keys()) {
+    FilePath filepath = getLatestVersionFilePath(versions[uuid]);
+    latest.insert(uuid, filepath);
+    LocalizedNameMap nameMap(ElementName("unknown"));
+    foreach (const auto& translation, translations.value(filepath)) {
+      nameMap.insert(translation.first,
+                     ElementName(translation.second));  // can throw
+    }
+    names.insert(filepath, *nameMap.value(localeOrder));
+  }
+}
+
 int WorkspaceLibraryDb::getLibraryId(const FilePath& lib) const {
   QString   relativeLibraryPath = lib.toRelative(mWorkspace.getLibrariesPath());
   QSqlQuery query               = mDb->prepareQuery(
@@ -806,6 +1045,8 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`mtime` INTEGER NOT NULL, "
+      "`hash` BLOB NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`parent_uuid` TEXT"
@@ -828,6 +1069,8 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`mtime` INTEGER NOT NULL, "
+      "`hash` BLOB NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`parent_uuid` TEXT"
@@ -850,6 +1093,8 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`mtime` INTEGER NOT NULL, "
+      "`hash` BLOB NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL"
       ")");
@@ -879,6 +1124,8 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`mtime` INTEGER NOT NULL, "
+      "`hash` BLOB NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL "
       ")");
@@ -908,6 +1155,8 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`mtime` INTEGER NOT NULL, "
+      "`hash` BLOB NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL"
       ")");
@@ -937,6 +1186,8 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`mtime` INTEGER NOT NULL, "
+      "`hash` BLOB NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`component_uuid` TEXT NOT NULL, "
@@ -967,6 +1218,79 @@ void WorkspaceLibraryDb::createAllTables() {
     QSqlQuery query = mDb->prepareQuery(string);  // can throw
     mDb->exec(query);                             // can throw
   }
+
+  // full-text search index (optional)
+  try {
+    createFullTextSearchTables();  // can throw
+  } catch (const Exception& e) {
+    qWarning() << "Could not create full-text search index:" << e.getMsg();
+  }
+}
+
+void WorkspaceLibraryDb::createFullTextSearchTables() {
+  // For each translation table, an external content FTS5 table indexes the
+  // names and keywords. It is kept in sync by triggers, so the library
+  // scanner doesn't need to care about it. The prefix indices make prefix
+  // queries with 2 or 3 characters (i.e. while typing) fast, and the rank
+  // function weights matches in the name higher than in the keywords.
+  QStringList tables = {"libraries", "component_categories",
+                        "package_categories", "symbols", "packages",
+                        "components", "devices"};
+  QStringList queries;
+  foreach (const QString& table, tables) {
+    queries << QString(
+                   "CREATE VIRTUAL TABLE IF NOT EXISTS %1_fts USING fts5("
+                   "name, keywords, content='%1_tr', content_rowid='id', "
+                   "tokenize='unicode61 remove_diacritics 1', prefix='2 3'"
+                   ")")
+                   .arg(table);
+    queries << QString(
+                   "INSERT INTO %1_fts(%1_fts, rank) "
+                   "VALUES ('rank', 'bm25(10.0, 1.0)')")
+                   .arg(table);
+    queries << QString(
+                   "CREATE TRIGGER IF NOT EXISTS %1_fts_insert "
+                   "AFTER INSERT ON %1_tr BEGIN "
+                   "INSERT INTO %1_fts(rowid, name, keywords) "
+                   "VALUES (new.id, new.name, new.keywords); "
+                   "END")
+                   .arg(table);
+    queries << QString(
+                   "CREATE TRIGGER IF NOT EXISTS %1_fts_delete "
+                   "AFTER DELETE ON %1_tr BEGIN "
+                   "INSERT INTO %1_fts(%1_fts, rowid, name, keywords) "
+                   "VALUES ('delete', old.id, old.name, old.keywords); "
+                   "END")
+                   .arg(table);
+    queries << QString(
+                   "CREATE TRIGGER IF NOT EXISTS %1_fts_update "
+                   "AFTER UPDATE ON %1_tr BEGIN "
+                   "INSERT INTO %1_fts(%1_fts, rowid, name, keywords) "
+                   "VALUES ('delete', old.id, old.name, old.keywords); "
+                   "INSERT INTO %1_fts(rowid, name, keywords) "
+                   "VALUES (new.id, new.name, new.keywords); "
+                   "END")
+                   .arg(table);
+  }
+
+  SQLiteDatabase::TransactionScopeGuard transactionGuard(*mDb);  // can throw
+  foreach (const QString& string, queries) {
+    QSqlQuery query = mDb->prepareQuery(string);  // can throw
+    mDb->exec(query);                             // can throw
+  }
+  transactionGuard.commit();  // can throw
+}
+
+bool WorkspaceLibraryDb::hasFullTextSearchTables() const noexcept {
+  try {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT COUNT(*) FROM sqlite_master "
+        "WHERE type = 'table' AND name = 'devices_fts'");
+    mDb->exec(query);
+    return query.next() && (query.value(0).toInt() > 0);
+  } catch (const Exception& e) {
+    return false;
+  }
 }
 
 int WorkspaceLibraryDb::getDbVersion() const noexcept {
@@ -32,6 +32,8 @@
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
+class QSqlQuery;
+
 namespace librepcb {
 
 class Version;
@@ -53,6 +55,23 @@ class WorkspaceLibraryDb final : public QObject {
   Q_OBJECT
 
 public:
+  // Types
+
+  /// A device found by #searchComponentsAndDevices()
+  struct DeviceSearchResult {
+    QString  name;
+    FilePath pkgFp;  ///< Invalid if the package is not in the library
+    QString  pkgName;
+    bool     match = false;  ///< Whether the device itself matches
+  };
+
+  /// A component found by #searchComponentsAndDevices()
+  struct ComponentSearchResult {
+    QString                             name;
+    QHash<FilePath, DeviceSearchResult> devices;
+    bool match = false;  ///< Whether the component itself matches
+  };
+
   // Constructors / Destructor
   WorkspaceLibraryDb()                                = delete;
   WorkspaceLibraryDb(const WorkspaceLibraryDb& other) = delete;
@@ -70,6 +89,7 @@ public:
 
   // Getters: Attributes
   const FilePath& getFilePath() const noexcept { return mFilePath; }
+  bool            hasFullTextSearch() const noexcept { return mFullTextSearch; }
 
   // Getters: Libraries
   QMultiMap<Version, FilePath> getLibraries() const;
@@ -93,8 +113,40 @@ public:
   FilePath getLatestDevice(const Uuid& uuid) const;
 
   // Getters: Library elements by search keyword
+
+  /**
+   * @brief Search library elements by their name and keywords
+   *
+   * Every word of the keyword must match the beginning of a word in the name
+   * or keywords of an element (in any locale). The results are ordered by
+   * relevance, with matches in the name ranked higher than matches in the
+   * keywords. If the SQLite library doesn't support full-text search, a
+   * (slow) substring search is performed instead.
+   *
+   * @param keyword   The search term entered by the user
+   * @param limit     Maximum number of results (-1 for no limit)
+   *
+   * @return UUIDs of all matching elements, most relevant first
+   */
   template <typename ElementType>
-  QList<Uuid> getElementsBySearchKeyword(const QString& keyword) const;
+  QList<Uuid> getElementsBySearchKeyword(const QString& keyword,
+                                         int            limit = -1) const;
+
+  /**
+   * @brief Search components and devices by their name and keywords
+   *
+   * Returns the latest version of all matching components together with all
+   * their devices, and of all matching devices together with their component.
+   * The package and all names are resolved as well, so this replaces a lot of
+   * single lookups with only a few joined queries.
+   *
+   * @param keyword       The search term entered by the user
+   * @param localeOrder   Locale order to determine the element names
+   *
+   * @return Found components (by their file path) with their devices
+   */
+  QHash<FilePath, ComponentSearchResult> searchComponentsAndDevices(
+      const QString& keyword, const QStringList& localeOrder) const;
 
   // Getters: Library elements of a specified library
   template <typename ElementType>
@@ -136,6 +188,21 @@ public:
    */
   void startLibraryRescan() noexcept;
 
+  // Static Methods
+
+  /**
+   * @brief Build the FTS5 query expression for a search keyword
+   *
+   * Every word of the keyword is quoted, so FTS5 operators and special
+   * characters (e.g. `-`, `*` or `"`) are not interpreted. Each word must
+   * match the beginning of a token.
+   *
+   * @param keyword   The search term entered by the user
+   *
+   * @return The FTS5 query (empty if the keyword doesn't contain any word)
+   */
+  static QString buildFullTextSearchQuery(const QString& keyword) noexcept;
+
   // Operator Overloadings
   WorkspaceLibraryDb& operator=(const WorkspaceLibraryDb& rhs) = delete;
 
@@ -176,11 +243,26 @@ private:
               const tl::optional<Uuid>& categoryUuid) const;
   QList<Uuid>     getElementsBySearchKeyword(const QString& tablename,
                                              const QString& idrowname,
-                                             const QString& keyword) const;
+                                             const QString& keyword,
+                                             int            limit) const;
+  QString         getSearchKeywordFilter(const QString& tablename,
+                                         const QString& idrowname,
+                                         QStringList& placeholders) const
+      noexcept;
+  static void     bindSearchKeywordValue(QSqlQuery&         query,
+                                         const QStringList& placeholders,
+                                         const QString&     value) noexcept;
+  QString         getSearchKeywordValue(const QString& keyword) const noexcept;
+  void getLatestSearchElements(QSqlQuery& query, const QStringList& localeOrder,
+                               QHash<QString, FilePath>&     latest,
+                               QHash<FilePath, QString>&     names,
+                               QHash<FilePath, QStringList>& data) const;
   int             getLibraryId(const FilePath& lib) const;
   QList<FilePath> getLibraryElements(const FilePath& lib,
                                      const QString&  tablename) const;
   void            createAllTables();
+  void            createFullTextSearchTables();
+  bool            hasFullTextSearchTables() const noexcept;
   void            setDbVersion(int version);
   int             getDbVersion() const noexcept;
 
@@ -189,9 +271,10 @@ private:
   FilePath                       mFilePath;  ///< path to the SQLite database
   QScopedPointer<SQLiteDatabase> mDb;        ///< the SQLite database
   QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
+  bool mFullTextSearch;  ///< whether the FTS5 search index is available
 
   // Constants
-  static const int sCurrentDbVersion = 2;
+  static const int sCurrentDbVersion = 4;
 };
 
 /*******************************************************************************
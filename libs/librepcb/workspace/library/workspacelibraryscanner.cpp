@@ -25,10 +25,13 @@
 #include "../workspace.h"
 
 #include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/common/sqlitedatabase.h>
 #include <librepcb/common/toolbox.h>
 #include <librepcb/library/elements.h>
+#include <librepcb/library/libraryelementheader.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -89,6 +92,37 @@ QVariant WorkspaceLibraryScanner::optionalToVariant(
   return opt ? **opt : QVariant();
 }
 
+template <>
+void WorkspaceLibraryScanner::getElementMetadata<ComponentCategory>(
+    const LibraryElementHeader& header, ElementRecord& record) {
+  tl::optional<Uuid> parent =
+      header.getRoot().getValueByPath<tl::optional<Uuid>>("parent");
+  record.columns.insert("parent_uuid",
+                        parent ? parent->toStr() : QVariant(QVariant::String));
+}
+
+template <>
+void WorkspaceLibraryScanner::getElementMetadata<PackageCategory>(
+    const LibraryElementHeader& header, ElementRecord& record) {
+  tl::optional<Uuid> parent =
+      header.getRoot().getValueByPath<tl::optional<Uuid>>("parent");
+  record.columns.insert("parent_uuid",
+                        parent ? parent->toStr() : QVariant(QVariant::String));
+}
+
+template <>
+void WorkspaceLibraryScanner::getElementMetadata<Device>(
+    const LibraryElementHeader& header, ElementRecord& record) {
+  record.columns.insert(
+      "component_uuid",
+      header.getRoot().getValueByPath<Uuid>("component").toStr());
+  record.columns.insert(
+      "package_uuid", header.getRoot().getValueByPath<Uuid>("package").toStr());
+  foreach (const Uuid& uuid, header.getCategories()) {
+    record.categories.append(uuid.toStr());
+  }
+}
+
 void WorkspaceLibraryScanner::run() noexcept {
   qDebug() << "Workspace library scanner thread started.";
 
@@ -130,54 +164,70 @@ void WorkspaceLibraryScanner::scan() noexcept {
     // begin database transaction
     SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
 
-    // clear all tables
-    clearAllTables(db);
+    // get fingerprints of all elements currently in the database
+    QStringList tables = {"component_categories", "package_categories",
+                          "symbols",              "packages",
+                          "components",           "devices"};
+    QHash<QString, QHash<QString, DbElement>> dbElements;
+    foreach (const QString& table, tables) {
+      dbElements[table] = getElementsFromDb(db, table);  // can throw
+    }
 
     // scan all libraries
-    int   count   = 0;
-    qreal percent = 1;
+    int   count       = 0;
+    int   parsedCount = 0;
+    qreal percent     = 1;
     foreach (const QString& fp, libraries.keys()) {
       Q_ASSERT(libIds.contains(fp));
       int                             libId = libIds[fp];
       const std::shared_ptr<Library>& lib   = libraries[fp];
       Q_ASSERT(lib);
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addCategoriesToDb<ComponentCategory>(
+      count += updateElementsInDb<ComponentCategory>(
           db, fs, fp, lib->searchForElements<ComponentCategory>(),
-          "component_categories", "cat_id", libId);
+          "component_categories", "cat_id", libId,
+          dbElements["component_categories"], parsedCount);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addCategoriesToDb<PackageCategory>(
+      count += updateElementsInDb<PackageCategory>(
           db, fs, fp, lib->searchForElements<PackageCategory>(),
-          "package_categories", "cat_id", libId);
+          "package_categories", "cat_id", libId,
+          dbElements["package_categories"], parsedCount);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count +=
-          addElementsToDb<Symbol>(db, fs, fp, lib->searchForElements<Symbol>(),
-                                  "symbols", "symbol_id", libId);
+      count += updateElementsInDb<Symbol>(
+          db, fs, fp, lib->searchForElements<Symbol>(), "symbols", "symbol_id",
+          libId, dbElements["symbols"], parsedCount);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Package>(db, fs, fp,
-                                        lib->searchForElements<Package>(),
-                                        "packages", "package_id", libId);
+      count += updateElementsInDb<Package>(
+          db, fs, fp, lib->searchForElements<Package>(), "packages",
+          "package_id", libId, dbElements["packages"], parsedCount);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Component>(db, fs, fp,
-                                          lib->searchForElements<Component>(),
-                                          "components", "component_id", libId);
+      count += updateElementsInDb<Component>(
+          db, fs, fp, lib->searchForElements<Component>(), "components",
+          "component_id", libId, dbElements["components"], parsedCount);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count +=
-          addElementsToDb<Device>(db, fs, fp, lib->searchForElements<Device>(),
-                                  "devices", "device_id", libId);
+      count += updateElementsInDb<Device>(
+          db, fs, fp, lib->searchForElements<Device>(), "devices", "device_id",
+          libId, dbElements["devices"], parsedCount);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
     }
 
+    // remove all elements which were not found anymore
+    if ((!mAbort) && (mSemaphore.available() == 0)) {
+      foreach (const QString& table, tables) {
+        removeElementsFromDb(db, table, dbElements[table]);  // can throw
+      }
+    }
+
     // commit transaction
     if ((!mAbort) && (mSemaphore.available() == 0)) {
       transactionGuard.commit();  // can throw
-      qDebug() << "Workspace library scan succeeded:" << count << "elements in"
-               << timer.elapsed() << "ms";
+      qDebug() << "Workspace library scan succeeded:" << count << "elements ("
+               << parsedCount << "parsed) in" << timer.elapsed() << "ms";
       emit scanSucceeded(count);
     } else {
       qDebug() << "Workspace library scan aborted after" << timer.elapsed()
@@ -303,187 +353,215 @@ QHash<QString, int> WorkspaceLibraryScanner::updateLibraries(
   return dbLibIds;
 }
 
-void WorkspaceLibraryScanner::clearAllTables(SQLiteDatabase& db) {
-  // component categories
-  db.clearTable("component_categories_tr");
-  db.clearTable("component_categories");
-
-  // package categories
-  db.clearTable("package_categories_tr");
-  db.clearTable("package_categories");
-
-  // symbols
-  db.clearTable("symbols_tr");
-  db.clearTable("symbols_cat");
-  db.clearTable("symbols");
-
-  // packages
-  db.clearTable("packages_tr");
-  db.clearTable("packages_cat");
-  db.clearTable("packages");
-
-  // components
-  db.clearTable("components_tr");
-  db.clearTable("components_cat");
-  db.clearTable("components");
-
-  // devices
-  db.clearTable("devices_tr");
-  db.clearTable("devices_cat");
-  db.clearTable("devices");
+QHash<QString, WorkspaceLibraryScanner::DbElement>
+    WorkspaceLibraryScanner::getElementsFromDb(SQLiteDatabase& db,
+                                               const QString&  table) {
+  QHash<QString, DbElement> elements;
+  QSqlQuery                 query = db.prepareQuery(
+      "SELECT id, lib_id, filepath, mtime, hash FROM " % table);
+  db.exec(query);  // can throw
+  while (query.next()) {
+    DbElement element;
+    element.id    = query.value(0).toInt();
+    element.libId = query.value(1).toInt();
+    element.mtime = query.value(3).toLongLong();
+    element.hash  = query.value(4).toByteArray();
+    elements.insert(query.value(2).toString(), element);
+  }
+  return elements;
+}
+
+void WorkspaceLibraryScanner::removeElementsFromDb(
+    SQLiteDatabase& db, const QString& table,
+    const QHash<QString, DbElement>& elements) {
+  // Note: Translations and categories are removed by "ON DELETE CASCADE".
+  foreach (const DbElement& element, elements) {
+    QSqlQuery query =
+        db.prepareQuery("DELETE FROM " % table % " WHERE id = :id");
+    query.bindValue(":id", element.id);
+    db.exec(query);  // can throw
+  }
 }
 
 template <typename ElementType>
-int WorkspaceLibraryScanner::addCategoriesToDb(
+int WorkspaceLibraryScanner::updateElementsInDb(
     SQLiteDatabase& db, std::shared_ptr<TransactionalFileSystem> fs,
     const QString& libPath, const QStringList& dirs, const QString& table,
-    const QString& idColumn, int libId) {
-  int count = 0;
+    const QString& idColumn, int libId, QHash<QString, DbElement>& dbElements,
+    int& parsedCount) {
+  // Parsing the elements is done by a pool of worker threads, while only
+  // this thread writes to the database. Make sure all workers are finished
+  // before leaving this method, even in case of an exception.
+  int                           count = 0;
+  QList<QFuture<ElementRecord>> futures;
+  auto                          sg = scopeGuard([&futures]() {
+    foreach (QFuture<ElementRecord> future, futures) {
+      future.waitForFinished();
+    }
+  });
+
   foreach (const QString& dirpath, dirs) {
-    if (mAbort || (mSemaphore.available() > 0)) break;
+    if (isAborted()) break;
     QString fullPath = libPath % "/" % dirpath;
+    QString mainFile =
+        fullPath % "/" % ElementType::getLongElementName() % ".lp";
     try {
-      std::unique_ptr<TransactionalDirectory> dir(
-          new TransactionalDirectory(fs, fullPath));  // can throw
-      ElementType element(std::move(dir));            // can throw
-      QSqlQuery   query = db.prepareQuery(
-          "INSERT INTO " % table %
-          " "
-          "(lib_id, filepath, uuid, version, parent_uuid) VALUES "
-          "(:lib_id, :filepath, :uuid, :version, :parent_uuid)");
-      query.bindValue(":lib_id", libId);
-      query.bindValue(":filepath", fullPath);
-      query.bindValue(":uuid", element.getUuid().toStr());
-      query.bindValue(":version", element.getVersion().toStr());
-      query.bindValue(":parent_uuid", element.getParentUuid()
-                                          ? element.getParentUuid()->toStr()
-                                          : QVariant(QVariant::String));
-      int id = db.insert(query);
-      foreach (const QString& locale, element.getAllAvailableLocales()) {
+      // Determine the fingerprint of the element. The hash is only calculated
+      // if the modification time has changed, which makes a rescan without
+      // any changes very fast.
+      QDateTime modified =
+          qMax(QFileInfo(fs->getAbsPath(fullPath).toStr()).lastModified(),
+               QFileInfo(fs->getAbsPath(mainFile).toStr()).lastModified());
+      // Note: The element is removed from dbElements only once it is known
+      // to still exist, otherwise it would be kept in the database forever if
+      // reading it fails.
+      qint64    mtime     = modified.toMSecsSinceEpoch();
+      bool      inDb      = dbElements.contains(fullPath);
+      DbElement dbElement = dbElements.value(fullPath);
+      if (inDb && (dbElement.libId == libId) && (dbElement.mtime == mtime)) {
+        dbElements.remove(fullPath);
+        count++;
+        continue;  // not modified
+      }
+      FileView   content = fs->readView(mainFile);  // can throw
+      QByteArray hash    = QCryptographicHash::hash(content.getContent(),
+                                                 QCryptographicHash::Sha1)
+                            .toHex();
+      dbElements.remove(fullPath);
+      if (inDb && (dbElement.hash == hash)) {
+        // only the modification time has changed, not the content
         QSqlQuery query = db.prepareQuery(
-            "INSERT INTO " % table %
-            "_tr "
-            "(" %
-            idColumn %
-            ", locale, name, description, keywords) VALUES "
-            "(:element_id, :locale, :name, :description, :keywords)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":locale", locale);
-        query.bindValue(":name",
-                        optionalToVariant(element.getNames().tryGet(locale)));
-        query.bindValue(
-            ":description",
-            optionalToVariant(element.getDescriptions().tryGet(locale)));
-        query.bindValue(":keywords", optionalToVariant(
-                                         element.getKeywords().tryGet(locale)));
-        db.insert(query);
+            "UPDATE " % table %
+            " SET lib_id = :lib_id, mtime = :mtime WHERE id = :id");
+        query.bindValue(":lib_id", libId);
+        query.bindValue(":mtime", mtime);
+        query.bindValue(":id", dbElement.id);
+        db.exec(query);  // can throw
+        count++;
+        continue;
       }
-      count++;
+
+      // new or modified element -> remove it from the database and parse it
+      if (inDb) {
+        QSqlQuery query =
+            db.prepareQuery("DELETE FROM " % table % " WHERE id = :id");
+        query.bindValue(":id", dbElement.id);
+        db.exec(query);  // can throw
+      }
+      futures.append(QtConcurrent::run([this, fs, fullPath, mtime, hash]() {
+        return parseElement<ElementType>(fs, fullPath, mtime, hash);
+      }));
     } catch (const Exception& e) {
       qWarning() << "Failed to open library element:" << fullPath;
     }
   }
-  return count;
-}
 
-template <typename ElementType>
-int WorkspaceLibraryScanner::addElementsToDb(
-    SQLiteDatabase& db, std::shared_ptr<TransactionalFileSystem> fs,
-    const QString& libPath, const QStringList& dirs, const QString& table,
-    const QString& idColumn, int libId) {
-  int count = 0;
-  foreach (const QString& dirpath, dirs) {
-    if (mAbort || (mSemaphore.available() > 0)) break;
-    QString fullPath = libPath % "/" % dirpath;
-    try {
-      std::unique_ptr<TransactionalDirectory> dir(
-          new TransactionalDirectory(fs, fullPath));  // can throw
-      ElementType element(std::move(dir));            // can throw
-      addElementToDb(db, table, idColumn, libId, fullPath, element);
+  // write the parsed elements to the database in their original order
+  foreach (QFuture<ElementRecord> future, futures) {
+    const ElementRecord& record = future.result();  // blocks
+    if (isAborted()) {
+      break;  // remaining workers return immediately
+    } else if (record.error) {
+      qWarning() << "Failed to open library element:" << record.path;
+    } else {
+      addElementToDb(db, table, idColumn, libId, record);  // can throw
+      parsedCount++;
       count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << fullPath;
     }
   }
   return count;
 }
 
 template <typename ElementType>
-void WorkspaceLibraryScanner::addElementToDb(SQLiteDatabase& db,
-                                             const QString&  table,
-                                             const QString& idColumn, int libId,
-                                             const QString&     path,
-                                             const ElementType& element) {
-  QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                    " (lib_id, filepath, uuid, version) VALUES "
-                                    "(:lib_id, :filepath, :uuid, :version)");
-  query.bindValue(":lib_id", libId);
-  query.bindValue(":filepath", path);
-  query.bindValue(":uuid", element.getUuid().toStr());
-  query.bindValue(":version", element.getVersion().toStr());
-  int id = db.insert(query);
-  addElementTranslationsToDb(db, table % "_tr", idColumn, id, element);
-  addElementCategoriesToDb(db, table % "_cat", idColumn, id,
-                           element.getCategories());
+WorkspaceLibraryScanner::ElementRecord WorkspaceLibraryScanner::parseElement(
+    std::shared_ptr<TransactionalFileSystem> fs, const QString& path,
+    qint64 mtime, const QByteArray& hash) const noexcept {
+  ElementRecord record;
+  record.path  = path;
+  record.mtime = mtime;
+  record.hash  = hash;
+  if (isAborted()) {
+    record.error.reset(new LogicError(__FILE__, __LINE__, "Scan aborted."));
+    return record;
+  }
+  try {
+    // Only the metadata is needed, so don't construct the whole element.
+    TransactionalDirectory dir(fs, path);  // can throw
+    LibraryElementHeader   header =
+        LibraryElementHeader::open<ElementType>(dir);  // can throw
+    record.columns.insert("uuid", header.getUuid().toStr());
+    record.columns.insert("version", header.getVersion().toStr());
+    foreach (const QString& locale, header.getAllAvailableLocales()) {
+      ElementRecord::Translation translation;
+      translation.locale = locale;
+      translation.name = optionalToVariant(header.getNames().tryGet(locale));
+      translation.description =
+          optionalToVariant(header.getDescriptions().tryGet(locale));
+      translation.keywords =
+          optionalToVariant(header.getKeywords().tryGet(locale));
+      record.translations.append(translation);
+    }
+    getElementMetadata<ElementType>(header, record);  // can throw
+  } catch (const Exception& e) {
+    record.error.reset(e.clone());
+  }
+  return record;
 }
 
-template <>
-void WorkspaceLibraryScanner::addElementToDb<Device>(
-    SQLiteDatabase& db, const QString& table, const QString& idColumn,
-    int libId, const QString& path, const Device& element) {
-  QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                    " "
-                                    "(lib_id, filepath, uuid, version, "
-                                    "component_uuid, package_uuid) VALUES "
-                                    "(:lib_id, :filepath, :uuid, :version, "
-                                    ":component_uuid, :package_uuid)");
-  query.bindValue(":lib_id", libId);
-  query.bindValue(":filepath", path);
-  query.bindValue(":uuid", element.getUuid().toStr());
-  query.bindValue(":version", element.getVersion().toStr());
-  query.bindValue(":component_uuid", element.getComponentUuid().toStr());
-  query.bindValue(":package_uuid", element.getPackageUuid().toStr());
-  int id = db.insert(query);
-  addElementTranslationsToDb(db, table % "_tr", idColumn, id, element);
-  addElementCategoriesToDb(db, table % "_cat", idColumn, id,
-                           element.getCategories());
+template <typename ElementType>
+void WorkspaceLibraryScanner::getElementMetadata(
+    const LibraryElementHeader& header, ElementRecord& record) {
+  foreach (const Uuid& uuid, header.getCategories()) {
+    record.categories.append(uuid.toStr());
+  }
 }
 
-template <typename ElementType>
-void WorkspaceLibraryScanner::addElementTranslationsToDb(
-    SQLiteDatabase& db, const QString& table, const QString& idColumn, int id,
-    const ElementType& element) {
-  foreach (const QString& locale, element.getAllAvailableLocales()) {
+void WorkspaceLibraryScanner::addElementToDb(SQLiteDatabase&      db,
+                                             const QString&       table,
+                                             const QString&       idColumn,
+                                             int                  libId,
+                                             const ElementRecord& record) {
+  QStringList columns = {"lib_id", "filepath", "mtime", "hash"};
+  columns += record.columns.keys();
+  QSqlQuery query = db.prepareQuery(
+      "INSERT INTO " % table % " (" % columns.join(", ") % ") VALUES (:" %
+      columns.join(", :") % ")");
+  query.bindValue(":lib_id", libId);
+  query.bindValue(":filepath", record.path);
+  query.bindValue(":mtime", record.mtime);
+  query.bindValue(":hash", record.hash);
+  foreach (const QString& column, record.columns.keys()) {
+    query.bindValue(":" % column, record.columns.value(column));
+  }
+  int id = db.insert(query);  // can throw
+  foreach (const ElementRecord::Translation& translation,
+           record.translations) {
     QSqlQuery query = db.prepareQuery(
-        "INSERT INTO " % table % " (" % idColumn %
+        "INSERT INTO " % table % "_tr (" % idColumn %
         ", locale, name, description, keywords) VALUES "
         "(:element_id, :locale, :name, :description, :keywords)");
     query.bindValue(":element_id", id);
-    query.bindValue(":locale", locale);
-    query.bindValue(":name",
-                    optionalToVariant(element.getNames().tryGet(locale)));
-    query.bindValue(
-        ":description",
-        optionalToVariant(element.getDescriptions().tryGet(locale)));
-    query.bindValue(":keywords",
-                    optionalToVariant(element.getKeywords().tryGet(locale)));
-    db.insert(query);
+    query.bindValue(":locale", translation.locale);
+    query.bindValue(":name", translation.name);
+    query.bindValue(":description", translation.description);
+    query.bindValue(":keywords", translation.keywords);
+    db.insert(query);  // can throw
   }
-}
-
-void WorkspaceLibraryScanner::addElementCategoriesToDb(
-    SQLiteDatabase& db, const QString& table, const QString& idColumn, int id,
-    const QSet<Uuid>& categories) {
-  foreach (const Uuid& categoryUuid, categories) {
-    QSqlQuery query = db.prepareQuery("INSERT INTO " % table % " (" % idColumn %
+  foreach (const QString& categoryUuid, record.categories) {
+    QSqlQuery query = db.prepareQuery("INSERT INTO " % table % "_cat (" %
+                                      idColumn %
                                       ", category_uuid) VALUES "
                                       "(:element_id, :category_uuid)");
     query.bindValue(":element_id", id);
-    query.bindValue(":category_uuid", categoryUuid.toStr());
-    db.insert(query);
+    query.bindValue(":category_uuid", categoryUuid);
+    db.insert(query);  // can throw
   }
 }
 
+bool WorkspaceLibraryScanner::isAborted() const noexcept {
+  return mAbort || (mSemaphore.available() > 0);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -35,12 +35,14 @@
 
 namespace librepcb {
 
+class Exception;
 class Uuid;
 class SQLiteDatabase;
 class TransactionalFileSystem;
 
 namespace library {
 class Library;
+class LibraryElementHeader;
 }
 
 namespace workspace {
@@ -54,6 +56,11 @@ class Workspace;
 /**
  * @brief The WorkspaceLibraryScanner class
  *
+ * The scan is incremental: For each library element, a fingerprint (the last
+ * modification time of its directory and main file, and a hash of the main
+ * file) is stored in the database. Only new or modified elements are parsed
+ * and updated in the database, and elements which no longer exist are removed.
+ *
  * @warning Be very careful with dependencies to other objects as the #run()
  * method is executed in a separate thread! Keep the number of dependencies as
  * small as possible and consider thread synchronization and object lifetimes.
@@ -61,6 +68,30 @@ class Workspace;
 class WorkspaceLibraryScanner final : public QThread {
   Q_OBJECT
 
+  struct DbElement {
+    int        id;
+    int        libId;
+    qint64     mtime;
+    QByteArray hash;
+  };
+
+  /// Metadata of a parsed element, produced by the parser worker threads
+  struct ElementRecord {
+    struct Translation {
+      QString  locale;
+      QVariant name;
+      QVariant description;
+      QVariant keywords;
+    };
+    QString                    path;
+    qint64                     mtime;
+    QByteArray                 hash;
+    QMap<QString, QVariant>    columns;  ///< Table columns, e.g. "uuid"
+    QList<Translation>         translations;
+    QStringList                categories;
+    std::shared_ptr<Exception> error;  ///< Exceptions can't cross threads
+  };
+
 public:
   // Constructors / Destructor
   WorkspaceLibraryScanner(Workspace& ws, const FilePath& dbFilePath) noexcept;
@@ -88,32 +119,31 @@ private:  // Methods
   QHash<QString, int> updateLibraries(
       SQLiteDatabase&                                          db,
       const QHash<QString, std::shared_ptr<library::Library>>& libs);
-  void clearAllTables(SQLiteDatabase& db);
   void getLibrariesOfDirectory(
       std::shared_ptr<TransactionalFileSystem> fs, const QString& root,
       QHash<QString, std::shared_ptr<library::Library>>& libs) noexcept;
+  QHash<QString, DbElement> getElementsFromDb(SQLiteDatabase& db,
+                                              const QString&  table);
+  void removeElementsFromDb(SQLiteDatabase& db, const QString& table,
+                            const QHash<QString, DbElement>& elements);
   template <typename ElementType>
-  int addCategoriesToDb(SQLiteDatabase&                          db,
-                        std::shared_ptr<TransactionalFileSystem> fs,
-                        const QString& libPath, const QStringList& dirs,
-                        const QString& table, const QString& idColumn,
-                        int libId);
+  int updateElementsInDb(SQLiteDatabase&                          db,
+                         std::shared_ptr<TransactionalFileSystem> fs,
+                         const QString& libPath, const QStringList& dirs,
+                         const QString& table, const QString& idColumn,
+                         int libId, QHash<QString, DbElement>& dbElements,
+                         int& parsedCount);
   template <typename ElementType>
-  int addElementsToDb(SQLiteDatabase&                          db,
-                      std::shared_ptr<TransactionalFileSystem> fs,
-                      const QString& libPath, const QStringList& dirs,
-                      const QString& table, const QString& idColumn, int libId);
+  ElementRecord parseElement(std::shared_ptr<TransactionalFileSystem> fs,
+                             const QString& path, qint64 mtime,
+                             const QByteArray& hash) const noexcept;
   template <typename ElementType>
+  static void getElementMetadata(const library::LibraryElementHeader& header,
+                                 ElementRecord&                       record);
   void addElementToDb(SQLiteDatabase& db, const QString& table,
-                      const QString& idColumn, int libId, const QString& path,
-                      const ElementType& element);
-  template <typename ElementType>
-  void addElementTranslationsToDb(SQLiteDatabase& db, const QString& table,
-                                  const QString& idColumn, int id,
-                                  const ElementType& element);
-  void addElementCategoriesToDb(SQLiteDatabase& db, const QString& table,
-                                const QString& idColumn, int id,
-                                const QSet<Uuid>& categories);
+                      const QString& idColumn, int libId,
+                      const ElementRecord& record);
+  bool isAborted() const noexcept;
   template <typename T>
   static QVariant optionalToVariant(const T& opt) noexcept;
 
@@ -1,6 +1,7 @@
 #!/usr/bin/env python
 # -*- coding: utf-8 -*-
 
+import glob
 import os
 import params
 import pytest
@@ -28,3 +29,29 @@ def test_save(cli, project):
     assert len(stdout) > 0
     assert stdout[-1] == 'SUCCESS'
     assert os.path.getsize(path) != original_filesize
+
+
+def test_save_rewrites_board_and_schematic(cli):
+    project = params.EMPTY_PROJECT_LPP
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    # indent the second line a bit more (still valid, but not canonical)
+    paths = []
+    for pattern in ['boards/*/board.lp', 'schematics/*/schematic.lp']:
+        paths += glob.glob(os.path.join(cli.abspath(project.parent_dir),
+                                        pattern))
+    assert len(paths) > 0
+    original_contents = {}
+    for path in paths:
+        with open(path, 'rb') as f:
+            original_contents[path] = f.read()
+        with open(path, 'wb') as f:
+            f.write(original_contents[path].replace(b'\n', b'\n ', 1))
+    # save project (must restore the canonical files)
+    code, stdout, stderr = cli.run('open-project', '--save', project.path)
+    assert code == 0
+    assert len(stderr) == 0
+    assert len(stdout) > 0
+    assert stdout[-1] == 'SUCCESS'
+    for path in paths:
+        with open(path, 'rb') as f:
+            assert f.read() == original_contents[path]
@@ -1,7 +1,10 @@
 #!/usr/bin/env python
 # -*- coding: utf-8 -*-
 
+import glob
+import os
 import params
+import pytest
 
 """
 Test command "open-project --strict"
@@ -34,6 +37,30 @@ def test_invalid_lpp(cli):
     assert stdout[-1] == 'Finished with errors!'
 
 
+@pytest.mark.parametrize("pattern", [
+    'boards/*/board.lp',
+    'schematics/*/schematic.lp',
+])
+def test_invalid_board_or_schematic(cli, pattern):
+    project = params.EMPTY_PROJECT_LPP
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    # indent the second line a bit more (still valid, but not canonical)
+    paths = glob.glob(os.path.join(cli.abspath(project.parent_dir), pattern))
+    assert len(paths) > 0
+    with open(paths[0], 'rb') as f:
+        content = f.read()
+    with open(paths[0], 'wb') as f:
+        f.write(content.replace(b'\n', b'\n ', 1))
+    # open project
+    code, stdout, stderr = cli.run('open-project', '--strict', project.path)
+    assert code == 1
+    assert len(stderr) == 1
+    assert 'Non-canonical file:' in stderr[0]
+    assert os.path.basename(paths[0]) in stderr[0]
+    assert len(stdout) > 0
+    assert stdout[-1] == 'Finished with errors!'
+
+
 def test_lppz_fails(cli):
     project = params.PROJECT_WITH_TWO_BOARDS_LPPZ
     cli.add_project(project.dir, as_lppz=project.is_lppz)
@@ -0,0 +1,110 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/fileview.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class FileViewTest : public ::testing::Test {
+protected:
+  FilePath mTmpDir;
+
+  FileViewTest() { mTmpDir = FilePath::getRandomTempPath(); }
+
+  virtual ~FileViewTest() { QDir(mTmpDir.toStr()).removeRecursively(); }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(FileViewTest, testDefaultConstructor) {
+  FileView view;
+  EXPECT_FALSE(view.isMapped());
+  EXPECT_EQ(0, view.getSize());
+  EXPECT_EQ(QByteArray(), view.getContent());
+}
+
+TEST_F(FileViewTest, testConstructFromByteArray) {
+  FileView view(QByteArray("foo bar"));
+  EXPECT_FALSE(view.isMapped());
+  EXPECT_EQ(7, view.getSize());
+  EXPECT_EQ(QByteArray("foo bar"), view.getContent());
+  EXPECT_EQ(QByteArray("foo bar"), view.toByteArray());
+}
+
+TEST_F(FileViewTest, testMapNonExistingFile) {
+  EXPECT_THROW(FileView::map(mTmpDir.getPathTo("foo")), Exception);
+}
+
+TEST_F(FileViewTest, testMapEmptyFile) {
+  FilePath fp = mTmpDir.getPathTo("empty");
+  FileUtils::writeFile(fp, QByteArray());
+  FileView view = FileView::map(fp);
+  EXPECT_FALSE(view.isMapped());  // empty files cannot be mapped
+  EXPECT_EQ(0, view.getSize());
+}
+
+TEST_F(FileViewTest, testMapFile) {
+  FilePath fp = mTmpDir.getPathTo("file.txt");
+  FileUtils::writeFile(fp, "(librepcb_foo\n (bar 42)\n)\n");
+  FileView view = FileView::map(fp);
+  EXPECT_EQ(QByteArray("(librepcb_foo\n (bar 42)\n)\n"), view.getContent());
+}
+
+TEST_F(FileViewTest, testCopiesShareContent) {
+  FilePath fp = mTmpDir.getPathTo("file.txt");
+  FileUtils::writeFile(fp, "foo");
+  FileView copy;
+  {
+    FileView view = FileView::map(fp);
+    copy          = view;
+  }
+  EXPECT_EQ(QByteArray("foo"), copy.getContent());
+}
+
+TEST_F(FileViewTest, testToByteArrayOutlivesView) {
+  FilePath fp = mTmpDir.getPathTo("file.txt");
+  FileUtils::writeFile(fp, "foo");
+  QByteArray content = FileView::map(fp).toByteArray();
+  EXPECT_EQ(QByteArray("foo"), content);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
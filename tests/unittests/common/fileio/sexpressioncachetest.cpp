@@ -0,0 +1,121 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/sexpressioncache.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SExpressionCacheTest : public ::testing::Test {
+protected:
+  FilePath mTmpDir;
+  FilePath mCacheFile;
+
+  SExpressionCacheTest() {
+    mTmpDir    = FilePath::getRandomTempPath();
+    mCacheFile = mTmpDir.getPathTo(".cache/cache.bin");
+  }
+
+  virtual ~SExpressionCacheTest() {
+    QDir(mTmpDir.toStr()).removeRecursively();
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SExpressionCacheTest, testNonExistingFile) {
+  SExpressionCache cache(mCacheFile);
+  SExpression      s = cache.parse("(a (b c))", mTmpDir.getPathTo("a.lp"));
+  EXPECT_EQ("c", s.getValueByPath<QString>("b"));
+  cache.save();
+  EXPECT_TRUE(mCacheFile.isExistingFile());
+}
+
+TEST_F(SExpressionCacheTest, testCorruptFile) {
+  FileUtils::writeFile(mCacheFile, "foo");
+  SExpressionCache cache(mCacheFile);
+  SExpression      s = cache.parse("(a (b c))", mTmpDir.getPathTo("a.lp"));
+  EXPECT_EQ("c", s.getValueByPath<QString>("b"));
+}
+
+TEST_F(SExpressionCacheTest, testParseErrorIsNotCached) {
+  SExpressionCache cache(mCacheFile);
+  EXPECT_THROW(cache.parse("(a (b c)", FilePath()), Exception);
+  EXPECT_THROW(cache.parse("(a (b c)", FilePath()), Exception);
+}
+
+TEST_F(SExpressionCacheTest, testLoadFromCache) {
+  QByteArray content = "(a (b c))";
+  FilePath   fp      = mTmpDir.getPathTo("a.lp");
+  {
+    SExpressionCache cache(mCacheFile);
+    cache.parse(content, fp);
+    cache.save();
+  }
+  QByteArray cacheContent = FileUtils::readFile(mCacheFile);
+  {
+    SExpressionCache cache(mCacheFile);
+    SExpression      s = cache.parse(content, fp);
+    EXPECT_EQ(fp, s.getChildByPath("b").getFilePath());
+    EXPECT_EQ("(a (b \"c\"))\n", s.toByteArray());
+    cache.save();
+  }
+  // unchanged cache is not written again
+  EXPECT_EQ(cacheContent, FileUtils::readFile(mCacheFile));
+}
+
+TEST_F(SExpressionCacheTest, testUnusedEntriesAreDiscarded) {
+  {
+    SExpressionCache cache(mCacheFile);
+    cache.parse("(a)", FilePath());
+    cache.parse("(b)", FilePath());
+    cache.save();
+  }
+  qint64 sizeWithTwoEntries = QFileInfo(mCacheFile.toStr()).size();
+  {
+    SExpressionCache cache(mCacheFile);
+    cache.parse("(a)", FilePath());
+    cache.save();
+  }
+  EXPECT_LT(QFileInfo(mCacheFile.toStr()).size(), sizeWithTwoEntries);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,282 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/sexpression.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Data Type
+ ******************************************************************************/
+
+typedef struct {
+  QByteArray content;
+  int        line;    ///< Expected line of the parse error
+  int        column;  ///< Expected column of the parse error
+} SExpressionParseErrorTestData;
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SExpressionTest : public ::testing::Test {};
+
+class SExpressionParseErrorTest
+  : public ::testing::TestWithParam<SExpressionParseErrorTestData> {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SExpressionTest, testParseList) {
+  SExpression s = SExpression::parse(
+      "(root foo \"bar baz\"\n (child 1.5)\n (child -2))\n", FilePath());
+  EXPECT_TRUE(s.isList());
+  EXPECT_EQ("root", s.getName());
+  EXPECT_EQ(4, s.getChildren().count());
+  EXPECT_EQ("foo", s.getChildByIndex(0).getStringOrToken());
+  EXPECT_EQ("bar baz", s.getChildByIndex(1).getStringOrToken());
+  EXPECT_EQ(2, s.getChildren("child").count());
+  EXPECT_EQ("-2",
+            s.getChildren("child").at(1).get().getValueOfFirstChild<QString>());
+}
+
+TEST_F(SExpressionTest, testParseWithoutWhitespaces) {
+  SExpression s = SExpression::parse("(a(b(c)))", FilePath());
+  EXPECT_EQ("c", s.getChildByPath("b/c").getName());
+  EXPECT_EQ(0, s.getChildByPath("b/c").getChildren().count());
+}
+
+TEST_F(SExpressionTest, testParseStringEscapes) {
+  SExpression s = SExpression::parse(
+      "(s \"a\\\"b\\\\c\\nd\" \"\" \"\\t\")", FilePath());
+  EXPECT_EQ("a\"b\\c\nd", s.getChildByIndex(0).getStringOrToken());
+  EXPECT_EQ("", s.getChildByIndex(1).getStringOrToken());
+  EXPECT_EQ("\t", s.getChildByIndex(2).getStringOrToken());
+}
+
+TEST_F(SExpressionTest, testParseUtf8) {
+  SExpression s = SExpression::parse(
+      QString("(s \"\u00e4\u20ac\" \u00f6)").toUtf8(), FilePath());
+  EXPECT_EQ(QString("\u00e4\u20ac"), s.getChildByIndex(0).getStringOrToken());
+  EXPECT_EQ(QString("\u00f6"), s.getChildByIndex(1).getStringOrToken());
+}
+
+TEST_F(SExpressionTest, testParseComments) {
+  SExpression s = SExpression::parse(
+      "; comment\n(root ; comment (foo)\n bar)\n; comment", FilePath());
+  EXPECT_EQ(1, s.getChildren().count());
+  EXPECT_EQ("bar", s.getChildByIndex(0).getStringOrToken());
+}
+
+TEST_F(SExpressionTest, testParseFilePath) {
+  FilePath    fp("/tmp/foo.lp");
+  SExpression s = SExpression::parse("(root (child foo))", fp);
+  EXPECT_EQ(fp, s.getFilePath());
+  EXPECT_EQ(fp, s.getChildByPath("child").getFilePath());
+}
+
+TEST_F(SExpressionTest, testParseAndSerialize) {
+  QByteArray content =
+      "(librepcb_board 71762d7e-e7f1-403c-8020-db9670c01e9b\n"
+      " (name \"Foo \\\"Bar\\\"\")\n"
+      " (position 1.5 -2.25)\n"
+      ")\n";
+  SExpression s = SExpression::parse(content, FilePath());
+  EXPECT_EQ(SExpression::parse(s.toByteArray(), FilePath()).toByteArray(),
+            s.toByteArray());
+  EXPECT_EQ("Foo \"Bar\"", s.getValueByPath<QString>("name"));
+}
+
+TEST_F(SExpressionTest, testParsePartially) {
+  QByteArray content =
+      "(root uuid\n"
+      " (name (locale \"de_DE\") \"Foo\")\n"
+      " (pad \"a) (\\\"\" (pos 1 2) ; comment )\n"
+      " )\n"
+      " (category 1) (category 2)\n"
+      ")\n";
+  SExpression s =
+      SExpression::parsePartially(content, FilePath(), {"name", "category"});
+  EXPECT_EQ(4, s.getChildren().count());
+  EXPECT_EQ("uuid", s.getChildByIndex(0).getStringOrToken());
+  EXPECT_EQ("de_DE", s.getValueByPath<QString>("name/locale"));
+  EXPECT_EQ(2, s.getChildren("category").count());
+  EXPECT_EQ(nullptr, s.tryGetChildByPath("pad"));
+}
+
+TEST_F(SExpressionTest, testParsePartiallyUnclosedList) {
+  EXPECT_THROW(SExpression::parsePartially("(root (a (b)", FilePath(), {}),
+               FileParseError);
+}
+
+TEST_F(SExpressionTest, testGetChildrenDoesNotCopy) {
+  SExpression s = SExpression::parse("(root (a 1) (b 2) (a 3))", FilePath());
+  SExpression::ChildRefs children = s.getChildren("a");
+  ASSERT_EQ(2, children.count());
+  EXPECT_EQ(&s.getChildByIndex(0), &children.at(0).get());
+  EXPECT_EQ(&s.getChildByIndex(2), &children.at(1).get());
+  EXPECT_EQ(0, s.getChildren("c").count());
+}
+
+TEST_F(SExpressionTest, testGetChildByPath) {
+  SExpression s =
+      SExpression::parse("(root (a (b 1)) (c 2) (a (b 3)))", FilePath());
+  EXPECT_EQ(&s.getChildByIndex(2), &s.getChildByPath("a"));
+  EXPECT_EQ("3", s.getValueByPath<QString>("a/b"));  // last one wins
+  EXPECT_EQ("2", s.getValueByPath<QString>("c"));
+  EXPECT_EQ(nullptr, s.tryGetChildByPath("a/c"));
+  EXPECT_EQ(nullptr, s.tryGetChildByPath("d"));
+}
+
+TEST_F(SExpressionTest, testSerialize) {
+  SExpression s = SExpression::createList("root");
+  s.appendChild(SExpression::createToken("tok"), false);
+  s.appendChild("name", QString("a\"b\\c\n\u00e4"), true);
+  s.appendChild("empty", SExpression::createString(""), false);
+  s.appendChild("pos", SExpression::createToken("1.5"), true);
+  EXPECT_EQ(QString(
+                "(root tok\n"
+                " (name \"a\\\"b\\\\c\\n\u00e4\") (empty \"\")\n"
+                " (pos 1.5)\n"
+                ")\n")
+                .toUtf8(),
+            s.toByteArray());
+}
+
+TEST_F(SExpressionTest, testSerializeNestedLineBreaks) {
+  SExpression s = SExpression::createList("a");
+  s.appendList("b", true).appendList("c", true).appendChild(
+      SExpression::createToken("d"), false);
+  s.appendLineBreak();
+  s.appendLineBreak();
+  EXPECT_EQ("(a\n (b\n  (c d)\n )\n\n)\n", s.toByteArray());
+}
+
+TEST_F(SExpressionTest, testSerializeInvalidListName) {
+  EXPECT_THROW(SExpression::createList("Foo").toByteArray(), LogicError);
+  EXPECT_THROW(SExpression::createList("1foo").toByteArray(), LogicError);
+  EXPECT_THROW(SExpression::createList("").toByteArray(), LogicError);
+}
+
+TEST_F(SExpressionTest, testSerializeInvalidToken) {
+  SExpression s = SExpression::createList("foo");
+  s.appendChild(SExpression::createToken("a b"), false);
+  EXPECT_THROW(s.toByteArray(), LogicError);
+}
+
+TEST_F(SExpressionTest, testBinaryRoundTrip) {
+  SExpression s = SExpression::createList("root");
+  s.appendChild(SExpression::createToken("foo"), false);
+  s.appendChild(SExpression::createString("bar \"\xc3\xa4\""), false);
+  s.appendChild(SExpression::createString(""), false);
+  s.appendList("child", true).appendChild(SExpression::createToken("1.5"),
+                                          false);
+  s.appendLineBreak();
+  FilePath    fp("/tmp/foo.lp");
+  SExpression b = SExpression::fromBinary(s.toBinary(), fp);
+  EXPECT_EQ(s.toByteArray(), b.toByteArray());
+  EXPECT_EQ(SExpression::Type::Token, b.getChildByIndex(0).getType());
+  EXPECT_EQ(SExpression::Type::LineBreak, b.getChildByIndex(3).getType());
+  EXPECT_EQ(fp, b.getChildByPath("child").getChildByIndex(0).getFilePath());
+}
+
+TEST_F(SExpressionTest, testFromCorruptBinary) {
+  QByteArray data = SExpression::parse("(a (b c))", FilePath()).toBinary();
+  EXPECT_THROW(SExpression::fromBinary(data.left(data.size() - 1), FilePath()),
+               RuntimeError);
+  EXPECT_THROW(SExpression::fromBinary(data + "x", FilePath()), RuntimeError);
+  EXPECT_THROW(SExpression::fromBinary(QByteArray(), FilePath()),
+               RuntimeError);
+}
+
+// Not run by default, use --gtest_also_run_disabled_tests to measure the
+// parse throughput.
+TEST_F(SExpressionTest, DISABLED_benchmarkParse) {
+  QByteArray content = "(librepcb_board 71762d7e-e7f1-403c-8020-db9670c01e9b\n";
+  for (int i = 0; i < 100000; ++i) {
+    content +=
+        " (netsegment 1a3b2c4d-0000-4000-8000-000000000000\n"
+        "  (net 5e6f7a8b-0000-4000-8000-000000000000)\n"
+        "  (via 9c0d1e2f-0000-4000-8000-000000000000 (from top_cu) "
+        "(to bot_cu)\n"
+        "   (position 12.7 -25.4) (size 0.7) (drill 0.3) (shape round)\n"
+        "  )\n"
+        "  (line 3a4b5c6d-0000-4000-8000-000000000000 (width 0.5) "
+        "(layer \"top_cu\")\n"
+        "   (from (via 9c0d1e2f-0000-4000-8000-000000000000))\n"
+        "   (to (device 7e8f9a0b-0000-4000-8000-000000000000) (pad \"1\"))\n"
+        "  )\n"
+        " )\n";
+  }
+  content += ")\n";
+
+  QElapsedTimer timer;
+  timer.start();
+  SExpression s       = SExpression::parse(content, FilePath());
+  qint64      elapsed = qMax(timer.elapsed(), qint64(1));
+  EXPECT_EQ(100000, s.getChildren("netsegment").count());
+  qInfo() << "Parsed" << content.size() / 1000000.0 << "MB in" << elapsed
+          << "ms:" << (content.size() / 1000.0) / elapsed << "MB/s";
+}
+
+TEST_P(SExpressionParseErrorTest, testParseError) {
+  const SExpressionParseErrorTestData& data = GetParam();
+  try {
+    SExpression::parse(data.content, FilePath());
+    FAIL() << "No exception thrown.";
+  } catch (const FileParseError& e) {
+    QString pos = QString("Line,Column: %1,%2").arg(data.line).arg(data.column);
+    EXPECT_TRUE(e.getMsg().contains(pos)) << qPrintable(e.getMsg());
+  }
+}
+
+/*******************************************************************************
+ *  Test Data
+ ******************************************************************************/
+
+// clang-format off
+INSTANTIATE_TEST_SUITE_P(SExpressionParseErrorTest, SExpressionParseErrorTest, ::testing::Values(
+    SExpressionParseErrorTestData({"",                           1, 1}),  // no root
+    SExpressionParseErrorTestData({"(a) (b)",                    1, 5}),  // two roots
+    SExpressionParseErrorTestData({"(a))",                       1, 4}),  // too many ')'
+    SExpressionParseErrorTestData({"()",                         1, 2}),  // no name
+    SExpressionParseErrorTestData({"(a\n (b\n (c)",              2, 2}),  // not closed
+    SExpressionParseErrorTestData({"(a\n (b \"foo\n bar)",       2, 5}),  // string not terminated
+    SExpressionParseErrorTestData({"(a\n  (b \"x\\qy\"))",       2, 9})   // invalid escape
+));
+// clang-format on
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
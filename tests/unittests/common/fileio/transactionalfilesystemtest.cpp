@@ -135,6 +135,36 @@ TEST_F(TransactionalFileSystemTest, testWriteExistingFile) {
   EXPECT_EQ("new content", fs.read("1.txt"));
 }
 
+TEST_F(TransactionalFileSystemTest, testReadView) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  EXPECT_EQ("1", fs.readView("1.txt").getContent());
+  fs.write("1.txt", "new content");
+  EXPECT_FALSE(fs.readView("1.txt").isMapped());
+  EXPECT_EQ("new content", fs.readView("1.txt").getContent());
+  fs.removeFile("1.txt");
+  EXPECT_THROW(fs.readView("1.txt"), Exception);
+}
+
+TEST_F(TransactionalFileSystemTest, testWriteUnmodifiedContent) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write("1.txt", "new content");
+  fs.write("1.txt", "1");  // revert to the content on disk
+  fs.write("2.txt", "2");  // same content as on disk
+  fs.autosave();
+  EXPECT_EQ("1", fs.read("1.txt"));
+  FilePath autosaveFile = mPopulatedDir.getPathTo(".autosave/autosave.lp");
+  EXPECT_FALSE(FileUtils::readFile(autosaveFile).contains("modified_file"));
+}
+
+TEST_F(TransactionalFileSystemTest, testWriteUnmodifiedContentOfRemovedDir) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.removeDirRecursively("1");
+  fs.write("1/1a.txt", "1a");  // same content as on disk
+  fs.save();
+  EXPECT_EQ("1a", FileUtils::readFile(mPopulatedDir.getPathTo("1/1a.txt")));
+  EXPECT_FALSE(mPopulatedDir.getPathTo("1/1b.txt").isExistingFile());
+}
+
 TEST_F(TransactionalFileSystemTest, testWriteCreatesNewDirectoryAndFile) {
   TransactionalFileSystem fs(mPopulatedDir, true);
   ASSERT_FALSE(fs.fileExists("x/y/z"));
@@ -440,6 +470,44 @@ TEST_F(TransactionalFileSystemTest, testAutosaveIsRemovedInDestructor) {
   EXPECT_FALSE(fp.isExistingDir());
 }
 
+TEST_F(TransactionalFileSystemTest, testStartAutosaveThrowsIfNonWritable) {
+  TransactionalFileSystem fs(mPopulatedDir, false);
+  EXPECT_THROW(fs.startAutosave(), Exception);
+}
+
+TEST_F(TransactionalFileSystemTest, testStartAutosaveUsesSnapshot) {
+  FilePath                fp = mPopulatedDir.getPathTo(".autosave/autosave.lp");
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write("foo", "foo");
+  EXPECT_TRUE(fs.startAutosave());
+  fs.write("bar", "bar");  // must not affect the running autosave
+  fs.waitForAutosave();
+  ASSERT_TRUE(fp.isExistingFile());
+  QByteArray content = FileUtils::readFile(fp);
+  EXPECT_TRUE(content.contains("\"foo\""));
+  EXPECT_FALSE(content.contains("\"bar\""));
+}
+
+TEST_F(TransactionalFileSystemTest, testStartAutosaveIsRemovedWhenSaving) {
+  FilePath                fp = mPopulatedDir.getPathTo(".autosave");
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write("foo", "foo");
+  fs.startAutosave();
+  fs.save();  // waits for the running autosave
+  EXPECT_FALSE(fp.isExistingDir());
+  EXPECT_EQ("foo", FileUtils::readFile(fs.getAbsPath("foo")));
+}
+
+TEST_F(TransactionalFileSystemTest, testStartAutosaveIsRemovedInDestructor) {
+  FilePath fp = mPopulatedDir.getPathTo(".autosave");
+  {
+    TransactionalFileSystem fs(mPopulatedDir, true);
+    fs.write("foo", "foo");
+    fs.startAutosave();
+  }
+  EXPECT_FALSE(fp.isExistingDir());
+}
+
 TEST_F(TransactionalFileSystemTest, testRestoreAutosave) {
   TransactionalFileSystem fs(mPopulatedDir, true);
 
@@ -596,6 +664,52 @@ TEST_F(TransactionalFileSystemTest, testRestoredBackupAfterFailedSave) {
   EXPECT_FALSE(backupDir.isExistingDir());
 }
 
+TEST_F(TransactionalFileSystemTest, testAutosaveStoresObjectsOnlyOnce) {
+  FilePath                dir = mPopulatedDir.getPathTo(".autosave/objects");
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write("foo", "same content");
+  fs.write("bar", "same content");
+  fs.autosave();
+  ASSERT_EQ(1, FileUtils::getFilesInDirectory(dir).count());
+
+  // unchanged files must not be written again
+  FilePath object = FileUtils::getFilesInDirectory(dir).first();
+  FileUtils::writeFile(object, "marker");
+  fs.write("baz", "other content");
+  fs.autosave();
+  EXPECT_EQ(2, FileUtils::getFilesInDirectory(dir).count());
+  EXPECT_EQ("marker", FileUtils::readFile(object));
+
+  // objects which are not referenced anymore must be removed
+  fs.removeFile("foo");
+  fs.removeFile("bar");
+  fs.autosave();
+  EXPECT_EQ(1, FileUtils::getFilesInDirectory(dir).count());
+}
+
+TEST_F(TransactionalFileSystemTest, testRestoreAutosaveOfOlderVersion) {
+  // autosave as written by older application versions (a directory with
+  // copies of all modified files)
+  FilePath autosaveDir = mPopulatedDir.getPathTo(".autosave");
+  FileUtils::writeFile(autosaveDir.getPathTo("files/x/y"), "new file");
+  FileUtils::writeFile(autosaveDir.getPathTo("files/1.txt"), "new 1");
+  FileUtils::writeFile(autosaveDir.getPathTo("autosave.lp"),
+                       "(librepcb_autosave\n"
+                       " (created 2019-01-01T00:00:00Z)\n"
+                       " (modified_files_directory \"files\")\n"
+                       " (modified_file \"1.txt\")\n"
+                       " (modified_file \"x/y\")\n"
+                       " (removed_file \"2.txt\")\n"
+                       ")\n");
+
+  TransactionalFileSystem fs(mPopulatedDir, true,
+                             &TransactionalFileSystem::RestoreMode::yes);
+  EXPECT_TRUE(fs.isRestoredFromAutosave());
+  EXPECT_EQ("new file", fs.read("x/y"));
+  EXPECT_EQ("new 1", fs.read("1.txt"));
+  EXPECT_FALSE(fs.fileExists("2.txt"));
+}
+
 TEST_F(TransactionalFileSystemTest, testExportToZip) {
   FilePath zipFp = mPopulatedDir.getPathTo("export to.zip");
   ASSERT_FALSE(zipFp.isExistingFile());
@@ -604,6 +718,34 @@ TEST_F(TransactionalFileSystemTest, testExportToZip) {
   EXPECT_TRUE(zipFp.isExistingFile());
 }
 
+TEST_F(TransactionalFileSystemTest, testExportToZipAndLoadFromZip) {
+  QByteArray largeContent;
+  for (int i = 0; i < 10000; ++i) {
+    largeContent.append(QString("line %1\n").arg(i).toUtf8());
+  }
+  for (int level : {-1, 0, 1, 9}) {
+    FilePath zipFp = mTmpDir.getPathTo(QString("export_%1.zip").arg(level));
+    {
+      TransactionalFileSystem fs(mPopulatedDir, true);
+      fs.write("large.txt", largeContent);
+      fs.write("image.png", "not really an image");
+      fs.removeFile("2.txt");
+      fs.exportToZip(zipFp, level);
+    }
+    ASSERT_TRUE(zipFp.isExistingFile());
+
+    TransactionalFileSystem fs(mNonExistingDir, true);
+    fs.loadFromZip(zipFp);
+    EXPECT_EQ(largeContent, fs.read("large.txt"));
+    EXPECT_EQ("not really an image", fs.read("image.png"));
+    EXPECT_EQ("1", fs.read("1.txt"));
+    EXPECT_EQ("4", fs.read("1/2/3/4.txt"));
+    EXPECT_EQ("X", fs.read("foo dir/bar dir/X"));
+    EXPECT_FALSE(fs.fileExists("2.txt"));
+    EXPECT_FALSE(fs.fileExists(".dot/file.txt"));
+  }
+}
+
 TEST_F(TransactionalFileSystemTest, testDiscardChanges) {
   TransactionalFileSystem fs(mPopulatedDir, true);
 
@@ -0,0 +1,92 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ClipperHelpersTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ClipperHelpersTest, testBoundingRectOfEmptyPaths) {
+  ClipperLib::IntRect rect = ClipperHelpers::getBoundingRect({});
+  EXPECT_EQ(0, rect.left);
+  EXPECT_EQ(0, rect.top);
+  EXPECT_EQ(0, rect.right);
+  EXPECT_EQ(0, rect.bottom);
+}
+
+TEST_F(ClipperHelpersTest, testBoundingRectOfMultiplePaths) {
+  ClipperLib::Paths paths = {
+      {{10, 20}, {30, -40}, {50, 60}},
+      {{-70, 80}, {5, 5}},
+  };
+  ClipperLib::IntRect rect = ClipperHelpers::getBoundingRect(paths);
+  EXPECT_EQ(-70, rect.left);
+  EXPECT_EQ(-40, rect.top);
+  EXPECT_EQ(50, rect.right);
+  EXPECT_EQ(80, rect.bottom);
+}
+
+TEST_F(ClipperHelpersTest, testIntersectsOverlappingRects) {
+  ClipperLib::IntRect a = {0, 0, 100, 100};
+  ClipperLib::IntRect b = {50, 50, 150, 150};
+  EXPECT_TRUE(ClipperHelpers::intersects(a, b));
+  EXPECT_TRUE(ClipperHelpers::intersects(b, a));
+}
+
+TEST_F(ClipperHelpersTest, testIntersectsTouchingRects) {
+  ClipperLib::IntRect a = {0, 0, 100, 100};
+  ClipperLib::IntRect b = {100, 0, 200, 100};
+  EXPECT_TRUE(ClipperHelpers::intersects(a, b));
+  EXPECT_TRUE(ClipperHelpers::intersects(b, a));
+}
+
+TEST_F(ClipperHelpersTest, testIntersectsSeparatedRects) {
+  ClipperLib::IntRect a = {0, 0, 100, 100};
+  ClipperLib::IntRect b = {101, 0, 200, 100};
+  ClipperLib::IntRect c = {0, 101, 100, 200};
+  EXPECT_FALSE(ClipperHelpers::intersects(a, b));
+  EXPECT_FALSE(ClipperHelpers::intersects(b, a));
+  EXPECT_FALSE(ClipperHelpers::intersects(a, c));
+  EXPECT_FALSE(ClipperHelpers::intersects(c, a));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
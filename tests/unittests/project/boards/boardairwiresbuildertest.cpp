@@ -0,0 +1,261 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <delaunay-triangulation/delaunay.h>
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/boardairwiresbuilder.h>
+
+#include <QtCore>
+
+#include <list>
+#include <random>
+#include <unordered_map>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardAirWiresBuilderTest : public ::testing::Test {
+protected:
+  static QVector<Point> randomAnchors(int count, std::mt19937& rng) {
+    std::uniform_int_distribution<int> dist(-100000, 100000);  // in um
+    QVector<Point>                     anchors;
+    for (int i = 0; i < count; ++i) {
+      anchors.append(Point::fromMm(dist(rng) / 1000.0, dist(rng) / 1000.0));
+    }
+    return anchors;
+  }
+
+  static QVector<QPair<int, int>> randomConnections(int anchors, int count,
+                                                    std::mt19937& rng) {
+    std::uniform_int_distribution<int> dist(0, anchors - 1);
+    QVector<QPair<int, int>>           connections;
+    for (int i = 0; i < count; ++i) {
+      connections.append(qMakePair(dist(rng), dist(rng)));
+    }
+    return connections;
+  }
+
+  static qreal totalWeight(const QVector<QPair<Point, Point>>& airwires) {
+    qreal weight = 0;
+    foreach (const auto& airwire, airwires) {
+      qreal dx = airwire.first.getX().toNm() - airwire.second.getX().toNm();
+      qreal dy = airwire.first.getY().toNm() - airwire.second.getY().toNm();
+      weight += dx * dx + dy * dy;
+    }
+    return weight;
+  }
+
+  /**
+   * @brief Build the candidate edges (connections and Delaunay triangulation)
+   *        in the same way as BoardAirWiresBuilder does
+   */
+  static std::vector<delaunay::Edge<qreal>> buildEdges(
+      const QVector<Point>&                  anchors,
+      const QVector<QPair<int, int>>&        connections,
+      std::vector<delaunay::Vector2<qreal>>& aNodes) {
+    std::vector<delaunay::Edge<qreal>> aEdges;
+    for (int id = 0; id < anchors.count(); ++id) {
+      aNodes.emplace_back(anchors[id].getX().toNm(),
+                          anchors[id].getY().toNm(), id);
+    }
+    foreach (const auto& connection, connections) {
+      aEdges.emplace_back(aNodes[connection.first], aNodes[connection.second],
+                          -1);
+    }
+    std::size_t connectedEdges = aEdges.size();
+    if (aNodes.size() >= 3) {
+      delaunay::Delaunay<qreal> del;
+      del.triangulate(aNodes);
+      aEdges.insert(aEdges.end(), del.getEdges().begin(),
+                    del.getEdges().end());
+    } else if (aNodes.size() == 2) {
+      aEdges.emplace_back(aNodes[0], aNodes[1], -1);
+    }
+    for (std::size_t i = connectedEdges; i < aEdges.size(); ++i) {
+      aEdges[i].weight = aEdges[i].p1.dist2(aEdges[i].p2);
+    }
+    return aEdges;
+  }
+
+  /**
+   * @brief The original (tag based) implementation of the airwires builder,
+   *        used as reference for the current implementation
+   */
+  static QVector<QPair<Point, Point>> referenceMst(
+      const QVector<Point>&           anchors,
+      const QVector<QPair<int, int>>& connections) {
+    std::vector<delaunay::Vector2<qreal>> aNodes;
+    std::vector<delaunay::Edge<qreal>>    aEdges =
+        buildEdges(anchors, connections, aNodes);
+    return referenceKruskalMst(aEdges, aNodes);
+  }
+
+  static QVector<QPair<Point, Point>> referenceKruskalMst(
+      std::vector<delaunay::Edge<qreal>>&    aEdges,
+      std::vector<delaunay::Vector2<qreal>>& aNodes) {
+    unsigned int nodeNumber      = aNodes.size();
+    unsigned int mstExpectedSize = nodeNumber - 1;
+    unsigned int mstSize         = 0;
+    bool         ratsnestLines   = false;
+    QVector<QPair<Point, Point>> mst;
+    std::unordered_map<int, int> tags;
+    unsigned int                 tag = 0;
+    for (auto& node : aNodes) {
+      node.tag      = tag;
+      tags[node.id] = tag++;
+    }
+    std::vector<std::list<int>> cycles(nodeNumber);
+    for (unsigned int i = 0; i < nodeNumber; ++i) cycles[i].push_back(i);
+    std::sort(aEdges.begin(), aEdges.end(),
+              [](const delaunay::Edge<qreal>& a,
+                 const delaunay::Edge<qreal>& b) {
+                return a.weight > b.weight;
+              });
+    while (mstSize < mstExpectedSize && !aEdges.empty()) {
+      auto& dt     = aEdges.back();
+      int   srcTag = tags[dt.p1.id];
+      int   trgTag = tags[dt.p2.id];
+      if (srcTag != trgTag) {
+        if (!ratsnestLines && dt.weight >= 0) ratsnestLines = true;
+        for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
+             ++it) {
+          tags[aNodes[*it].id] = srcTag;
+        }
+        if (ratsnestLines) {
+          mst.append(
+              qMakePair(Point(dt.p1.x, dt.p1.y), Point(dt.p2.x, dt.p2.y)));
+          ++mstSize;
+        } else {
+          --mstExpectedSize;
+        }
+        cycles[srcTag].splice(cycles[srcTag].end(), cycles[trgTag]);
+      }
+      aEdges.pop_back();
+    }
+    return mst;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardAirWiresBuilderTest, testNoAnchors) {
+  EXPECT_TRUE(BoardAirWiresBuilder::buildMinimumSpanningTree({}, {}).isEmpty());
+}
+
+TEST_F(BoardAirWiresBuilderTest, testTwoAnchors) {
+  QVector<Point> anchors = {Point(0, 0), Point(1000, 0)};
+  QVector<QPair<Point, Point>> airwires =
+      BoardAirWiresBuilder::buildMinimumSpanningTree(anchors, {});
+  ASSERT_EQ(1, airwires.count());
+  EXPECT_EQ(1000000, totalWeight(airwires));
+  EXPECT_TRUE(BoardAirWiresBuilder::buildMinimumSpanningTree(
+                  anchors, {qMakePair(0, 1)})
+                  .isEmpty());
+}
+
+TEST_F(BoardAirWiresBuilderTest, testConnectedAnchorsNeedNoAirWire) {
+  // a square where three sides are connected
+  QVector<Point> anchors = {Point(0, 0), Point(1000, 0), Point(1000, 1000),
+                            Point(0, 1000)};
+  QVector<QPair<int, int>> connections = {qMakePair(0, 1), qMakePair(1, 2),
+                                          qMakePair(2, 3)};
+  EXPECT_TRUE(
+      BoardAirWiresBuilder::buildMinimumSpanningTree(anchors, connections)
+          .isEmpty());
+  connections.removeLast();
+  QVector<QPair<Point, Point>> airwires =
+      BoardAirWiresBuilder::buildMinimumSpanningTree(anchors, connections);
+  ASSERT_EQ(1, airwires.count());
+  EXPECT_EQ(1000000, totalWeight(airwires));
+}
+
+TEST_F(BoardAirWiresBuilderTest, testCompareWithReference) {
+  std::mt19937 rng(42);
+  for (int i = 0; i < 20; ++i) {
+    QVector<Point>           anchors = randomAnchors(50, rng);
+    QVector<QPair<int, int>> connections =
+        randomConnections(anchors.count(), i, rng);
+    QVector<QPair<Point, Point>> expected = referenceMst(anchors, connections);
+    QVector<QPair<Point, Point>> actual =
+        BoardAirWiresBuilder::buildMinimumSpanningTree(anchors, connections);
+    EXPECT_EQ(expected.count(), actual.count()) << "Iteration " << i;
+    EXPECT_EQ(totalWeight(expected), totalWeight(actual)) << "Iteration " << i;
+  }
+}
+
+// Not run by default, use --gtest_also_run_disabled_tests to compare the
+// airwires calculation time with the reference implementation. Since both
+// spend most of their time in the (identical) Delaunay triangulation, its time
+// is measured separately and subtracted to get the time of the MST stage.
+TEST_F(BoardAirWiresBuilderTest, DISABLED_benchmarkBuildMinimumSpanningTree) {
+  std::mt19937             rng(42);
+  QVector<Point>           anchors = randomAnchors(20000, rng);
+  QVector<QPair<int, int>> connections =
+      randomConnections(anchors.count(), 5000, rng);
+  QElapsedTimer timer;
+
+  // triangulation only
+  timer.start();
+  std::vector<delaunay::Vector2<qreal>> nodes;
+  std::vector<delaunay::Edge<qreal>>    edges =
+      buildEdges(anchors, connections, nodes);
+  qint64 triangulationMs = timer.elapsed();
+  EXPECT_FALSE(edges.empty());
+
+  // reference implementation
+  timer.restart();
+  QVector<QPair<Point, Point>> expected = referenceMst(anchors, connections);
+  qint64 referenceMs = timer.elapsed();
+
+  // current implementation
+  timer.restart();
+  QVector<QPair<Point, Point>> actual =
+      BoardAirWiresBuilder::buildMinimumSpanningTree(anchors, connections);
+  qint64 actualMs = timer.elapsed();
+
+  EXPECT_EQ(expected.count(), actual.count());
+  EXPECT_EQ(totalWeight(expected), totalWeight(actual));
+  qInfo() << "Built" << actual.count() << "airwires of" << anchors.count()
+          << "anchors, triangulation took" << triangulationMs << "ms";
+  qInfo() << "Reference:" << referenceMs << "ms total,"
+          << (referenceMs - triangulationMs) << "ms MST";
+  qInfo() << "Current:  " << actualMs << "ms total,"
+          << (actualMs - triangulationMs) << "ms MST";
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
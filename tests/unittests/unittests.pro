@@ -26,7 +26,6 @@ LIBS += \
     -llibrepcbproject \
     -llibrepcblibrary \    # Note: The order of the libraries is very important for the linker!
     -llibrepcbcommon \     # Another order could end up in "undefined reference" errors!
-    -lsexpresso \
     -lclipper \
     -lparseagle -lquazip -lz
 
@@ -47,7 +46,6 @@ DEPENDPATH += \
     ../../libs/librepcb/common \
     ../../libs/parseagle \
     ../../libs/quazip \
-    ../../libs/sexpresso \
     ../../libs/clipper \
 
 PRE_TARGETDEPS += \
@@ -58,7 +56,6 @@ PRE_TARGETDEPS += \
     $${DESTDIR}/liblibrepcblibrary.a \
     $${DESTDIR}/liblibrepcbcommon.a \
     $${DESTDIR}/libquazip.a \
-    $${DESTDIR}/libsexpresso.a \
     $${DESTDIR}/libclipper.a \
 
 SOURCES += \
@@ -70,7 +67,10 @@ SOURCES += \
     common/fileio/csvfiletest.cpp \
     common/fileio/directorylocktest.cpp \
     common/fileio/filepathtest.cpp \
+    common/fileio/fileviewtest.cpp \
     common/fileio/serializableobjectlisttest.cpp \
+    common/fileio/sexpressioncachetest.cpp \
+    common/fileio/sexpressiontest.cpp \
     common/fileio/transactionaldirectorytest.cpp \
     common/fileio/transactionalfilesystemtest.cpp \
     common/geometry/pathmodeltest.cpp \
@@ -89,6 +89,7 @@ SOURCES += \
     common/units/lengthtest.cpp \
     common/units/pointtest.cpp \
     common/units/ratiotest.cpp \
+    common/utils/clipperhelperstest.cpp \
     common/uuidtest.cpp \
     common/versiontest.cpp \
     common/widgets/editabletablewidgettest.cpp \
@@ -101,11 +102,14 @@ SOURCES += \
     library/cmp/componentsymbolvariantitemtest.cpp \
     library/librarybaseelementtest.cpp \
     main.cpp \
+    project/boards/boardairwiresbuildertest.cpp \
     project/boards/boardgerberexporttest.cpp \
     project/boards/boardpickplacegeneratortest.cpp \
     project/boards/boardplanefragmentsbuildertest.cpp \
     project/library/projectlibrarytest.cpp \
     project/projecttest.cpp \
+    workspace/library/workspacelibrarydbtest.cpp \
+    workspace/library/workspacelibraryscannertest.cpp \
     workspace/workspacetest.cpp \
 
 HEADERS += \
@@ -113,6 +117,7 @@ HEADERS += \
     common/fileio/serializableobjectmock.h \
     common/network/networkrequestbasesignalreceiver.h \
     common/widgets/editabletablewidgetreceiver.h \
+    workspace/library/workspacelibraryfixture.h \
 
 FORMS += \
 
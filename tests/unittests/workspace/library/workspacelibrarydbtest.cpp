@@ -0,0 +1,262 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "workspacelibraryfixture.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/common/sqlitedatabase.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace tests {
+
+using namespace librepcb::library;
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class WorkspaceLibraryDbTest : public WorkspaceLibraryFixture {
+protected:
+  typedef WorkspaceLibraryDb::ComponentSearchResult ComponentSearchResult;
+  typedef WorkspaceLibraryDb::DeviceSearchResult    DeviceSearchResult;
+
+  Uuid mPkgUuid  = Uuid::createRandom();
+  Uuid mCmpUuid  = Uuid::createRandom();
+  Uuid mDev1Uuid = Uuid::createRandom();
+  Uuid mDev2Uuid = Uuid::createRandom();
+
+  /**
+   * @brief Add a component "Transistor" with the devices "BC847" and "BC857",
+   *        both with the package "SOT23"
+   */
+  void addTransistor(
+      const QString&                           version = "1",
+      std::shared_ptr<TransactionalFileSystem> fs      = nullptr) {
+    Version v = Version::fromString(version);
+    Package pkg(mPkgUuid, v, "test", ElementName("SOT23"), "", "");
+    addElement(pkg, fs);
+    Component cmp(mCmpUuid, v, "test", ElementName("Transistor"), "", "");
+    addElement(cmp, fs);
+    Device dev1(mDev1Uuid, v, "test", ElementName("BC847"), "", "", mCmpUuid,
+                mPkgUuid);
+    addElement(dev1, fs);
+    Device dev2(mDev2Uuid, v, "test", ElementName("BC857"), "", "", mCmpUuid,
+                mPkgUuid);
+    addElement(dev2, fs);
+  }
+
+  QHash<FilePath, ComponentSearchResult> searchComponentsAndDevices(
+      const QString& keyword) {
+    return mWs->getLibraryDb().searchComponentsAndDevices(keyword, {});
+  }
+
+  QList<Uuid> search(const QString& keyword) {
+    return mWs->getLibraryDb().getElementsBySearchKeyword<Symbol>(keyword);
+  }
+
+  /**
+   * @brief Check if the full-text search index matches the translations table
+   */
+  void checkFullTextSearchIndex() {
+    if (mWs->getLibraryDb().hasFullTextSearch()) {
+      EXPECT_NO_THROW(execSql(
+          "INSERT INTO symbols_fts(symbols_fts) VALUES('integrity-check')"));
+    }
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testBuildFullTextSearchQuery) {
+  EXPECT_EQ("", WorkspaceLibraryDb::buildFullTextSearchQuery(""));
+  EXPECT_EQ("", WorkspaceLibraryDb::buildFullTextSearchQuery(" \t "));
+  EXPECT_EQ("\"foo\"*", WorkspaceLibraryDb::buildFullTextSearchQuery("foo"));
+  EXPECT_EQ("\"foo\"* \"bar\"*",
+            WorkspaceLibraryDb::buildFullTextSearchQuery(" foo \t bar "));
+  EXPECT_EQ("\"NOT\"* \"OR\"*",
+            WorkspaceLibraryDb::buildFullTextSearchQuery("NOT OR"));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testBuildFullTextSearchQueryQuoting) {
+  EXPECT_EQ("\"\"\"\"*", WorkspaceLibraryDb::buildFullTextSearchQuery("\""));
+  EXPECT_EQ("\"a\"\"b\"*",
+            WorkspaceLibraryDb::buildFullTextSearchQuery("a\"b"));
+  EXPECT_EQ("\"*\"*", WorkspaceLibraryDb::buildFullTextSearchQuery("*"));
+  EXPECT_EQ("\"R*\"*", WorkspaceLibraryDb::buildFullTextSearchQuery("R*"));
+  EXPECT_EQ("\"-\"*", WorkspaceLibraryDb::buildFullTextSearchQuery("-"));
+  EXPECT_EQ("\"-foo\"*", WorkspaceLibraryDb::buildFullTextSearchQuery("-foo"));
+  EXPECT_EQ("\"SOT-23\"*",
+            WorkspaceLibraryDb::buildFullTextSearchQuery("SOT-23"));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchWithSpecialCharacters) {
+  Uuid sot23 = addSymbol("SOT-23");
+  addSymbol("Diode");
+  scan();
+  EXPECT_EQ(QList<Uuid>{sot23}, search("SOT-23"));
+  EXPECT_EQ(QList<Uuid>{sot23}, search("sot"));
+  EXPECT_NO_THROW(search("\""));
+  EXPECT_NO_THROW(search("*"));
+  EXPECT_NO_THROW(search("-"));
+  EXPECT_NO_THROW(search("sot\" OR \"diode"));
+  EXPECT_NO_THROW(search("NOT"));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchNameRankedBeforeKeywords) {
+  Uuid byKeyword = addSymbol("Diode", "capacitor");
+  Uuid byName    = addSymbol("Capacitor");
+  scan();
+  EXPECT_EQ((QList<Uuid>{byName, byKeyword}), search("capacitor"));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchIndexFollowsInsertedElements) {
+  EXPECT_TRUE(search("capacitor").isEmpty());
+  Uuid sym = addSymbol("Capacitor");
+  scan();
+  EXPECT_EQ(QList<Uuid>{sym}, search("capacitor"));
+  checkFullTextSearchIndex();
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchIndexFollowsUpdatedElements) {
+  Uuid sym = addSymbol("Capacitor");
+  scan();
+  renameSymbol(sym, "Inductor");
+  execSql("UPDATE symbols SET mtime = 0");  // don't rely on the file system
+  scan();
+  EXPECT_TRUE(search("capacitor").isEmpty());
+  EXPECT_EQ(QList<Uuid>{sym}, search("inductor"));
+  checkFullTextSearchIndex();
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchIndexFollowsRemovedElements) {
+  Uuid sym1 = addSymbol("Capacitor 1");
+  Uuid sym2 = addSymbol("Capacitor 2");
+  scan();
+  removeSymbol(sym1);
+  scan();
+  EXPECT_EQ(QList<Uuid>{sym2}, search("capacitor"));
+  checkFullTextSearchIndex();
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchComponentsAndDevicesNoMatch) {
+  addTransistor();
+  scan();
+  EXPECT_TRUE(searchComponentsAndDevices("diode").isEmpty());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchComponentsAndDevicesByDeviceName) {
+  addTransistor();
+  scan();
+  WorkspaceLibraryDb&                    db = mWs->getLibraryDb();
+  QHash<FilePath, ComponentSearchResult> result =
+      searchComponentsAndDevices("bc847");
+  ASSERT_EQ(1, result.count());
+  FilePath cmpFp = db.getLatestComponent(mCmpUuid);
+  ASSERT_TRUE(result.contains(cmpFp));
+  const ComponentSearchResult& cmp = result[cmpFp];
+  EXPECT_EQ("Transistor", cmp.name);
+  EXPECT_FALSE(cmp.match);
+  ASSERT_EQ(1, cmp.devices.count());  // only the matching device
+  FilePath devFp = db.getLatestDevice(mDev1Uuid);
+  ASSERT_TRUE(cmp.devices.contains(devFp));
+  EXPECT_EQ("BC847", cmp.devices[devFp].name);
+  EXPECT_TRUE(cmp.devices[devFp].match);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchComponentsAndDevicesByComponentName) {
+  addTransistor();
+  scan();
+  WorkspaceLibraryDb&                    db = mWs->getLibraryDb();
+  QHash<FilePath, ComponentSearchResult> result =
+      searchComponentsAndDevices("transistor");
+  ASSERT_EQ(1, result.count());
+  FilePath cmpFp = db.getLatestComponent(mCmpUuid);
+  ASSERT_TRUE(result.contains(cmpFp));
+  const ComponentSearchResult& cmp = result[cmpFp];
+  EXPECT_EQ("Transistor", cmp.name);
+  EXPECT_TRUE(cmp.match);
+  ASSERT_EQ(2, cmp.devices.count());  // all devices of the component
+  FilePath dev1Fp = db.getLatestDevice(mDev1Uuid);
+  FilePath dev2Fp = db.getLatestDevice(mDev2Uuid);
+  ASSERT_TRUE(cmp.devices.contains(dev1Fp));
+  ASSERT_TRUE(cmp.devices.contains(dev2Fp));
+  EXPECT_EQ("BC847", cmp.devices[dev1Fp].name);
+  EXPECT_EQ("BC857", cmp.devices[dev2Fp].name);
+  EXPECT_FALSE(cmp.devices[dev1Fp].match);
+  EXPECT_FALSE(cmp.devices[dev2Fp].match);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchComponentsAndDevicesPackage) {
+  addTransistor();
+  scan();
+  WorkspaceLibraryDb&                    db = mWs->getLibraryDb();
+  QHash<FilePath, ComponentSearchResult> result =
+      searchComponentsAndDevices("transistor");
+  ASSERT_EQ(1, result.count());
+  FilePath pkgFp = db.getLatestPackage(mPkgUuid);
+  ASSERT_TRUE(pkgFp.isValid());
+  foreach (const DeviceSearchResult& dev, result.begin()->devices) {
+    EXPECT_EQ(pkgFp, dev.pkgFp);
+    EXPECT_EQ("SOT23", dev.pkgName);
+  }
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchComponentsAndDevicesLatestVersion) {
+  addTransistor("1");
+  addTransistor("2", addLibrary("Newer"));
+  scan();
+  WorkspaceLibraryDb&                    db = mWs->getLibraryDb();
+  QHash<FilePath, ComponentSearchResult> result =
+      searchComponentsAndDevices("transistor");
+  ASSERT_EQ(1, result.count());
+  FilePath cmpFp = db.getLatestComponent(mCmpUuid);
+  EXPECT_TRUE(cmpFp.toStr().contains("Newer.lplib"));
+  ASSERT_TRUE(result.contains(cmpFp));
+  const ComponentSearchResult& cmp = result[cmpFp];
+  ASSERT_EQ(2, cmp.devices.count());
+  FilePath devFp = db.getLatestDevice(mDev1Uuid);
+  EXPECT_TRUE(devFp.toStr().contains("Newer.lplib"));
+  ASSERT_TRUE(cmp.devices.contains(devFp));
+  EXPECT_EQ(db.getLatestPackage(mPkgUuid), cmp.devices[devFp].pkgFp);
+  EXPECT_TRUE(cmp.devices[devFp].pkgFp.toStr().contains("Newer.lplib"));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace workspace
+}  // namespace librepcb
@@ -0,0 +1,163 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WORKSPACELIBRARYFIXTURE_H
+#define WORKSPACELIBRARYFIXTURE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/sqlitedatabase.h>
+#include <librepcb/library/library.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/workspace.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace tests {
+
+/*******************************************************************************
+ *  Class WorkspaceLibraryFixture
+ ******************************************************************************/
+
+/**
+ * @brief Test fixture providing a temporary workspace with a local library
+ *
+ * Library elements can be added to, modified in and removed from the library,
+ * and #scan() updates the workspace library database synchronously.
+ */
+class WorkspaceLibraryFixture : public ::testing::Test {
+protected:
+  FilePath                                 mWsDir;
+  QScopedPointer<Workspace>                mWs;
+  std::shared_ptr<TransactionalFileSystem> mLibFs;  ///< The default library
+
+  WorkspaceLibraryFixture() {
+    mWsDir = FilePath::getRandomTempPath().getPathTo("workspace");
+    Workspace::createNewWorkspace(mWsDir);
+    mWs.reset(new Workspace(mWsDir));
+    mLibFs = addLibrary("Test");
+  }
+
+  virtual ~WorkspaceLibraryFixture() {
+    mLibFs.reset();
+    mWs.reset();
+    QDir(mWsDir.getParentDir().toStr()).removeRecursively();
+  }
+
+  /**
+   * @brief Create an empty library in the workspace
+   *
+   * @param name    Name of the library, also used as directory name
+   *
+   * @return The file system of the created library
+   */
+  std::shared_ptr<TransactionalFileSystem> addLibrary(const QString& name) {
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRW(
+            mWs->getLibrariesPath().getPathTo("local/" % name % ".lplib"));
+    TransactionalDirectory dir(fs);
+    library::Library lib(Uuid::createRandom(), Version::fromString("1"),
+                         "test", ElementName(name), "", "");
+    lib.moveTo(dir);
+    fs->save();
+    return fs;
+  }
+
+  /**
+   * @brief Add a newly created element to a library
+   *
+   * @param element   The element to add
+   * @param fs        The library to add the element to (default library if
+   *                  nullptr)
+   */
+  template <typename ElementType>
+  void addElement(ElementType&                             element,
+                  std::shared_ptr<TransactionalFileSystem> fs = nullptr) {
+    if (!fs) fs = mLibFs;
+    TransactionalDirectory dir(fs, ElementType::getShortElementName());
+    element.moveIntoParentDirectory(dir);
+    fs->save();
+  }
+
+  Uuid addSymbol(const QString& name, const QString& keywords = QString()) {
+    library::Symbol sym(Uuid::createRandom(), Version::fromString("1"), "test",
+                        ElementName(name), "", keywords);
+    addElement(sym);
+    return sym.getUuid();
+  }
+
+  void renameSymbol(const Uuid& uuid, const QString& name) {
+    library::Symbol sym(std::unique_ptr<TransactionalDirectory>(
+        new TransactionalDirectory(mLibFs, "sym/" % uuid.toStr())));
+    sym.setNames(LocalizedNameMap(ElementName(name)));
+    sym.save();
+    mLibFs->save();
+  }
+
+  void removeSymbol(const Uuid& uuid) {
+    mLibFs->removeDirRecursively("sym/" % uuid.toStr());
+    mLibFs->save();
+  }
+
+  /**
+   * @brief Run a scan and wait until it is finished
+   *
+   * @return The number of elements reported by the scanner, or -1 on failure
+   */
+  int scan() {
+    WorkspaceLibraryDb& db    = mWs->getLibraryDb();
+    int                 count = -1;
+    QEventLoop          loop;
+    QObject::connect(&db, &WorkspaceLibraryDb::scanSucceeded, &loop,
+                     [&count](int elementCount) { count = elementCount; });
+    QObject::connect(&db, &WorkspaceLibraryDb::scanFinished, &loop,
+                     &QEventLoop::quit);
+    QTimer::singleShot(60000, &loop, &QEventLoop::quit);  // timeout
+    db.startLibraryRescan();
+    loop.exec();
+    return count;
+  }
+
+  /**
+   * @brief Modify the database behind the scanner's back
+   */
+  void execSql(const QString& sql) {
+    SQLiteDatabase db(mWs->getLibraryDb().getFilePath());
+    db.exec(sql);
+  }
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace workspace
+}  // namespace librepcb
+
+#endif  // WORKSPACELIBRARYFIXTURE_H
@@ -0,0 +1,126 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "workspacelibraryfixture.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace tests {
+
+using namespace librepcb::library;
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class WorkspaceLibraryScannerTest : public WorkspaceLibraryFixture {
+protected:
+  QString getSymbolName(const Uuid& uuid) {
+    WorkspaceLibraryDb& db = mWs->getLibraryDb();
+    FilePath            fp = db.getLatestSymbol(uuid);
+    if (!fp.isValid()) {
+      return QString();
+    }
+    QString name;
+    db.getElementTranslations<Symbol>(fp, {}, &name);
+    return name;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryScannerTest, testNewElements) {
+  Uuid sym1 = addSymbol("Symbol 1");
+  Uuid sym2 = addSymbol("Symbol 2");
+  EXPECT_EQ(2, scan());
+  EXPECT_EQ("Symbol 1", getSymbolName(sym1));
+  EXPECT_EQ("Symbol 2", getSymbolName(sym2));
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testUnmodifiedElementsAreSkipped) {
+  Uuid sym = addSymbol("Symbol");
+  EXPECT_EQ(1, scan());
+
+  // If the element was parsed again, this modification would be reverted.
+  execSql("UPDATE symbols_tr SET name = 'Modified'");
+  EXPECT_EQ(1, scan());
+  EXPECT_EQ("Modified", getSymbolName(sym));
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testElementsWithSameHashAreSkipped) {
+  Uuid sym = addSymbol("Symbol");
+  EXPECT_EQ(1, scan());
+
+  // A different modification time but the same content must not lead to
+  // parsing the element again, but the modification time must be updated.
+  execSql("UPDATE symbols_tr SET name = 'Modified'");
+  execSql("UPDATE symbols SET mtime = 0");
+  EXPECT_EQ(1, scan());
+  EXPECT_EQ("Modified", getSymbolName(sym));
+  execSql("UPDATE symbols_tr SET name = 'Modified again'");
+  EXPECT_EQ(1, scan());
+  EXPECT_EQ("Modified again", getSymbolName(sym));
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testUpdatedElements) {
+  Uuid sym1 = addSymbol("Symbol 1");
+  Uuid sym2 = addSymbol("Symbol 2");
+  EXPECT_EQ(2, scan());
+
+  // Reset the modification time in the database as well, since the file
+  // system might not be able to distinguish modifications within a short time.
+  renameSymbol(sym1, "Renamed");
+  execSql("UPDATE symbols SET mtime = 0");
+  EXPECT_EQ(2, scan());
+  EXPECT_EQ("Renamed", getSymbolName(sym1));
+  EXPECT_EQ("Symbol 2", getSymbolName(sym2));
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testRemovedElements) {
+  Uuid sym1 = addSymbol("Symbol 1");
+  Uuid sym2 = addSymbol("Symbol 2");
+  EXPECT_EQ(2, scan());
+
+  removeSymbol(sym1);
+  EXPECT_EQ(1, scan());
+  EXPECT_FALSE(mWs->getLibraryDb().getLatestSymbol(sym1).isValid());
+  EXPECT_EQ("Symbol 2", getSymbolName(sym2));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace workspace
+}  // namespace librepcb